@@ -0,0 +1,283 @@
+#include "../Headers/ChunkPortals.h"
+#include "../Headers/Pathfinder.h"
+#include <algorithm>
+
+ChunkPortals::ChunkPortals(ChunkedGrid& grid, size_t maxBytes)
+    : grid(grid), maxBytes(maxBytes)
+{
+}
+
+const ChunkPortals::Chunk& ChunkPortals::examine(int chunk, int entitySize, std::vector<int>& labels)
+{
+    const int chunkSize = ChunkedGrid::chunkSize;
+    const int chunkX = chunk % grid.getChunksX();
+    const int chunkY = chunk / grid.getChunksX();
+    const int left = chunkX * chunkSize;
+    const int top = chunkY * chunkSize;
+    const int right = (std::min)(left + chunkSize, grid.getWidth()) - 1;
+    const int bottom = (std::min)(top + chunkSize, grid.getHeight()) - 1;
+    const int width = right - left + 1;
+    const int height = bottom - top + 1;
+
+    // The chunk with a tile around it, and the footprints reaching out of it right and down
+    const int originX = (std::max)(0, left - 1);
+    const int originY = (std::max)(0, top - 1);
+    OccupancyGrid tiles;
+    grid.copyRect(originX, originY, right + entitySize, bottom + entitySize, tiles);
+    auto fits = [&](int x, int y) {
+        return tiles.isRectFree(x - originX, y - originY, x - originX + entitySize - 1, y - originY + entitySize - 1);
+    };
+
+    labels.assign(static_cast<size_t>(width) * height, -1);
+    std::vector<char> open(labels.size());
+    for (int i = 0; i < static_cast<int>(open.size()); ++i)
+        open[i] = fits(left + i % width, top + i / width);
+
+    int regionCount = 0;
+    std::vector<int> pending;
+    for (int seed = 0; seed < static_cast<int>(labels.size()); ++seed) {
+        if (!open[seed] || labels[seed] >= 0)
+            continue;
+        labels[seed] = regionCount;
+        pending.push_back(seed);
+        while (!pending.empty()) {
+            const int i = pending.back();
+            pending.pop_back();
+            const int x = i % width;
+            const int y = i / width;
+            auto reach = [&](int next) {
+                if (open[next] && labels[next] < 0) {
+                    labels[next] = regionCount;
+                    pending.push_back(next);
+                }
+            };
+            if (x > 0) reach(i - 1);
+            if (x + 1 < width) reach(i + 1);
+            if (y > 0) reach(i - width);
+            if (y + 1 < height) reach(i + width);
+        }
+        ++regionCount;
+    }
+
+    auto& known = chunks[entitySize];
+    auto found = known.find(chunk);
+    if (found != known.end())
+        return found->second;
+
+    // Entrances of each side, found along the border the same way from either chunk
+    Chunk& result = known[chunk];
+    for (int side = 0; side < SideCount; ++side) {
+        result.sideStart[side] = static_cast<int>(result.doors.size());
+        const bool vertical = side == Right || side == Left;
+        const int dx = side == Right ? 1 : side == Left ? -1 : 0;
+        const int dy = side == Bottom ? 1 : side == Top ? -1 : 0;
+        const int x0 = side == Right ? right : left;
+        const int y0 = side == Bottom ? bottom : top;
+        if (!(side == Right ? right + 1 < grid.getWidth() : side == Bottom ? bottom + 1 < grid.getHeight() :
+            side == Left ? left > 0 : top > 0))
+            continue;
+
+        const int length = vertical ? height : width;
+        auto crossing = [&](int i) {
+            const int x = x0 + (vertical ? 0 : i);
+            const int y = y0 + (vertical ? i : 0);
+            return open[(y - top) * width + (x - left)] && fits(x + dx, y + dy);
+        };
+        auto addDoor = [&](int i) {
+            const int x = x0 + (vertical ? 0 : i);
+            const int y = y0 + (vertical ? i : 0);
+            result.doors.push_back(Door{ x, y, labels[(y - top) * width + (x - left)] });
+        };
+
+        int i = 0;
+        while (i < length) {
+            if (!crossing(i)) {
+                ++i;
+                continue;
+            }
+            const int first = i;
+            while (i < length && crossing(i))
+                ++i;
+            const int last = i - 1;
+
+            // Long entrances get a door at each end, short ones in the middle
+            if (last - first + 1 >= 6) {
+                addDoor(first);
+                addDoor(last);
+            }
+            else {
+                addDoor((first + last) / 2);
+            }
+        }
+    }
+    result.sideStart[SideCount] = static_cast<int>(result.doors.size());
+    usedBytes += bytesOf(result);
+    return result;
+}
+
+const ChunkPortals::Chunk& ChunkPortals::doorsOf(int chunk, int entitySize)
+{
+    auto& known = chunks[entitySize];
+    auto found = known.find(chunk);
+    if (found != known.end())
+        return found->second;
+    return examine(chunk, entitySize, scratchLabels);
+}
+
+int ChunkPortals::doorNode(int chunk, int door, const Door& at)
+{
+    const long long key = static_cast<long long>(chunk) << 8 | door;
+    auto found = doorNodes.find(key);
+    if (found != doorNodes.end())
+        return found->second;
+
+    const int id = static_cast<int>(routeNodes.size());
+    routeNodes.push_back(RouteNode{ chunk, door, at.x, at.y });
+    searchNodes.emplace_back();
+    doorNodes.emplace(key, id);
+    return id;
+}
+
+bool ChunkPortals::findRoute(int xStart, int yStart, int xEnd, int yEnd, int entitySize, std::vector<Leg>& legs)
+{
+    legs.clear();
+    if (usedBytes > maxBytes) {
+        chunks.clear();
+        usedBytes = 0;
+    }
+
+    const int chunkSize = ChunkedGrid::chunkSize;
+    const int chunksX = grid.getChunksX();
+    auto chunkOf = [&](int x, int y) { return (y / chunkSize) * chunksX + x / chunkSize; };
+    auto regionAt = [&](const std::vector<int>& labels, int chunk, int x, int y) {
+        const int left = chunk % chunksX * chunkSize;
+        const int top = chunk / chunksX * chunkSize;
+        const int width = (std::min)(left + chunkSize, grid.getWidth()) - left;
+        if (x < left || y < top || x >= left + width || (y - top) * width + (x - left) >= static_cast<int>(labels.size()))
+            return -1;
+        return labels[(y - top) * width + (x - left)];
+    };
+
+    const int startChunk = chunkOf(xStart, yStart);
+    const int endChunk = chunkOf(xEnd, yEnd);
+    std::vector<int> labels;
+    examine(endChunk, entitySize, labels);
+    const int endRegion = regionAt(labels, endChunk, xEnd, yEnd);
+    if (endRegion < 0)
+        return false;
+
+    // An agent pressed against a wall may stand where it does not fit, it leaves by a tile next to it
+    examine(startChunk, entitySize, labels);
+    int startRegion = regionAt(labels, startChunk, xStart, yStart);
+    for (int i = 0; i < 9 && startRegion < 0; ++i)
+        startRegion = regionAt(labels, startChunk, xStart + i % 3 - 1, yStart + i / 3 - 1);
+    if (startRegion < 0)
+        return false;
+
+    if (startChunk == endChunk && startRegion == endRegion) {
+        legs.push_back(Leg{ startChunk, xStart, yStart, xEnd, yEnd });
+        return true;
+    }
+
+    routeNodes.clear();
+    searchNodes.clear();
+    doorNodes.clear();
+    openNodes.clear();
+    routeNodes.push_back(RouteNode{ startChunk, -1, xStart, yStart });
+    routeNodes.push_back(RouteNode{ endChunk, -1, xEnd, yEnd });
+    searchNodes.resize(2);
+
+    // Nodes are fresh for every route, one neither open nor closed has not been reached
+    auto reach = [&](int from, int to, int cost) {
+        const int startCost = searchNodes[from].startCost + cost;
+        SearchNode& next = searchNodes[to];
+        if (next.closed || (next.isOpen() && startCost >= next.startCost))
+            return;
+        next.startCost = startCost;
+        next.finishCost = Pathfinder::phyt(routeNodes[to].x, routeNodes[to].y, xEnd, yEnd);
+        next.totalCost = startCost + next.finishCost;
+        next.parent = from;
+        if (next.isOpen())
+            openNodes.decrease(searchNodes, to);
+        else
+            openNodes.push(searchNodes, to);
+    };
+
+    searchNodes[0].finishCost = Pathfinder::phyt(xStart, yStart, xEnd, yEnd);
+    searchNodes[0].totalCost = searchNodes[0].finishCost;
+    openNodes.push(searchNodes, 0);
+    bool found = false;
+    while (!openNodes.empty()) {
+        const int current = openNodes.pop(searchNodes);
+        if (current == 1) {
+            found = true;
+            break;
+        }
+        searchNodes[current].closed = true;
+
+        const RouteNode node = routeNodes[current];
+        const Chunk& here = doorsOf(node.chunk, entitySize);
+        const int region = node.door < 0 ? startRegion : here.doors[node.door].region;
+
+        // Across the border, onto the same entrance of the next chunk
+        if (node.door >= 0) {
+            int side = 0;
+            while (node.door >= here.sideStart[side + 1])
+                ++side;
+            const int offsets[SideCount] = { 1, chunksX, -1, -chunksX };
+            const int nextChunk = node.chunk + offsets[side];
+            const Chunk& there = doorsOf(nextChunk, entitySize);
+            const int door = there.sideStart[(side + 2) % SideCount] + node.door - here.sideStart[side];
+            reach(current, doorNode(nextChunk, door, there.doors[door]), 10);
+        }
+
+        // Through the region, to its other entrances and to the end when it lies there
+        for (int door = 0; door < static_cast<int>(here.doors.size()); ++door) {
+            const Door& at = here.doors[door];
+            if (door != node.door && at.region == region)
+                reach(current, doorNode(node.chunk, door, at), Pathfinder::phyt(node.x, node.y, at.x, at.y));
+        }
+        if (node.chunk == endChunk && region == endRegion)
+            reach(current, 1, Pathfinder::phyt(node.x, node.y, xEnd, yEnd));
+    }
+    if (!found)
+        return false;
+
+    // Nodes one after another in the same chunk make a leg, the others cross a border
+    std::vector<int> route;
+    for (int n = 1; n >= 0; n = searchNodes[n].parent)
+        route.push_back(n);
+    std::reverse(route.begin(), route.end());
+    for (size_t i = 0; i + 1 < route.size(); ++i) {
+        const RouteNode& from = routeNodes[route[i]];
+        const RouteNode& to = routeNodes[route[i + 1]];
+        if (from.chunk == to.chunk)
+            legs.push_back(Leg{ from.chunk, from.x, from.y, to.x, to.y });
+    }
+    return true;
+}
+
+void ChunkPortals::invalidate(int minX, int minY, int maxX, int maxY)
+{
+    const int chunkSize = ChunkedGrid::chunkSize;
+    const int chunksX = grid.getChunksX();
+    const int chunksY = grid.getChunksY();
+
+    // A tile decides whether footprints up and left of it fit, and the chunks
+    // next to those share their entrances
+    for (auto& bySize : chunks) {
+        const int fromX = (std::max)(0, (std::max)(0, minX - bySize.first + 1) / chunkSize - 1);
+        const int fromY = (std::max)(0, (std::max)(0, minY - bySize.first + 1) / chunkSize - 1);
+        const int toX = (std::min)(chunksX - 1, (std::max)(0, maxX) / chunkSize + 1);
+        const int toY = (std::min)(chunksY - 1, (std::max)(0, maxY) / chunkSize + 1);
+        for (int chunkY = fromY; chunkY <= toY; ++chunkY) {
+            for (int chunkX = fromX; chunkX <= toX; ++chunkX) {
+                auto found = bySize.second.find(chunkY * chunksX + chunkX);
+                if (found == bySize.second.end())
+                    continue;
+                usedBytes -= bytesOf(found->second);
+                bySize.second.erase(found);
+            }
+        }
+    }
+}
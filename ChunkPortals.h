@@ -0,0 +1,86 @@
+#pragma once
+#include "ChunkedGrid.h"
+#include "SearchNode.h"
+#include "OpenList.h"
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+// Entrances between the chunks of a ChunkedGrid, so that a long route is found
+// over chunks instead of over every tile between its ends. The tiles of a chunk
+// an entity fits on split into 4-connected regions, and each run of such tiles
+// along both sides of a chunk border is an entrance, as in HierarchicalMap. Two
+// entrances of a chunk are linked when they open onto the same region there.
+// A chunk is examined the first time a route reaches it and remembered, per
+// entity size, until its tiles change; past maxBytes everything is forgotten.
+class ChunkPortals {
+public:
+    static constexpr int windowChunks = 4; // chunks a side of the windows a route is searched in
+
+    // Part of a route that stays in one chunk, between two tiles of one region
+    // there; consecutive legs end and start on the two sides of a border
+    struct Leg {
+        int chunk;
+        int xFrom;
+        int yFrom;
+        int xTo;
+        int yTo;
+    };
+
+private:
+    enum Side { Right, Bottom, Left, Top, SideCount };
+
+    // A chunk's side of an entrance: its edge tile and that tile's region
+    struct Door {
+        int x;
+        int y;
+        int region;
+    };
+
+    struct Chunk {
+        std::vector<Door> doors; // by side, the same entrance order on both sides of a border
+        int sideStart[SideCount + 1] = {};
+    };
+
+    // Route search state, nodes 0 and 1 are the query's start and end
+    struct RouteNode {
+        int chunk;
+        int door;
+        int x;
+        int y;
+    };
+
+    ChunkedGrid& grid;
+    size_t maxBytes;
+    size_t usedBytes = 0;
+    std::unordered_map<int, std::unordered_map<int, Chunk>> chunks; // by entity size, then chunk
+
+    std::vector<RouteNode> routeNodes;
+    std::vector<SearchNode> searchNodes;
+    std::unordered_map<long long, int> doorNodes;
+    OpenList openNodes;
+    std::vector<int> scratchLabels;
+
+    static size_t bytesOf(const Chunk& chunk) { return sizeof(Chunk) + chunk.doors.size() * sizeof(Door); }
+    // Region of each tile of the chunk, row by row, -1 where the entity does not
+    // fit; the chunk's doors are worked out on the way unless they are known
+    const Chunk& examine(int chunk, int entitySize, std::vector<int>& labels);
+    const Chunk& doorsOf(int chunk, int entitySize);
+    int doorNode(int chunk, int door, const Door& at);
+
+public:
+    ChunkPortals(ChunkedGrid& grid, size_t maxBytes);
+    ~ChunkPortals() = default;
+
+    ChunkPortals(const ChunkPortals&) = delete;
+    ChunkPortals& operator=(const ChunkPortals&) = delete;
+
+    // Chunks a route between two tiles runs through, as legs to be searched one
+    // chunk at a time. False when no route exists; the end must fit the entity.
+    bool findRoute(int xStart, int yStart, int xEnd, int yEnd, int entitySize, std::vector<Leg>& legs);
+    // Forget what is known of the chunks around an inclusive rectangle whose
+    // tiles changed, entrances are shared with the neighbouring chunks
+    void invalidate(int minX, int minY, int maxX, int maxY);
+
+    size_t getMemoryBytes() const { return usedBytes; }
+};
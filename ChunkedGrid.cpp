@@ -0,0 +1,123 @@
+#include "../Headers/ChunkedGrid.h"
+#include <algorithm>
+
+ChunkedGrid::ChunkedGrid(int width, int height, size_t maxBytes, Generator generator)
+    : maxBytes(maxBytes), generator(std::move(generator))
+{
+    if (width <= 0 || height <= 0)
+        return;
+
+    this->width = width;
+    this->height = height;
+    chunksX = (width + chunkSize - 1) / chunkSize;
+    chunksY = (height + chunkSize - 1) / chunkSize;
+    states.assign(static_cast<size_t>(chunksX) * chunksY, ChunkState::Missing);
+}
+
+ChunkedGrid::ChunkState ChunkedGrid::load(int chunk)
+{
+    const ChunkState state = states[chunk];
+    if (state == ChunkState::Mixed) {
+        recentChunks.splice(recentChunks.begin(), recentChunks, mixedChunks.find(chunk)->second.recent);
+        return state;
+    }
+    if (state != ChunkState::Missing)
+        return state;
+
+    const int chunkX = chunk % chunksX;
+    const int chunkY = chunk / chunksX;
+    const int chunkWidth = (std::min)(chunkSize, width - chunkX * chunkSize);
+    const int chunkHeight = (std::min)(chunkSize, height - chunkY * chunkSize);
+    OccupancyGrid tiles(chunkWidth, chunkHeight);
+    if (generator)
+        generator(chunkX, chunkY, tiles);
+    ++generatedCount;
+
+    if (tiles.isRectFree(0, 0, chunkWidth - 1, chunkHeight - 1))
+        return states[chunk] = ChunkState::Free;
+    if (tiles.isRectBlocked(0, 0, chunkWidth - 1, chunkHeight - 1))
+        return states[chunk] = ChunkState::Blocked;
+
+    recentChunks.push_front(chunk);
+    usedBytes += tiles.getMemoryBytes();
+    mixedChunks[chunk] = MixedChunk{ std::move(tiles), recentChunks.begin() };
+
+    // The chunk just loaded is the most recent and stays, even alone over budget
+    while (usedBytes > maxBytes && recentChunks.size() > 1)
+        drop(recentChunks.back());
+    return states[chunk] = ChunkState::Mixed;
+}
+
+void ChunkedGrid::drop(int chunk)
+{
+    auto mixed = mixedChunks.find(chunk);
+    if (mixed != mixedChunks.end()) {
+        usedBytes -= mixed->second.tiles.getMemoryBytes();
+        recentChunks.erase(mixed->second.recent);
+        mixedChunks.erase(mixed);
+    }
+    states[chunk] = ChunkState::Missing;
+}
+
+bool ChunkedGrid::isBlocked(int x, int y)
+{
+    if (x < 0 || y < 0 || x >= width || y >= height)
+        return true;
+
+    const int chunk = (y / chunkSize) * chunksX + x / chunkSize;
+    switch (load(chunk)) {
+    case ChunkState::Free:
+        return false;
+    case ChunkState::Mixed:
+        return mixedChunks.find(chunk)->second.tiles.isBlocked(x % chunkSize, y % chunkSize);
+    default:
+        return true;
+    }
+}
+
+void ChunkedGrid::copyRect(int minX, int minY, int maxX, int maxY, OccupancyGrid& window)
+{
+    minX = (std::max)(minX, 0);
+    minY = (std::max)(minY, 0);
+    maxX = (std::min)(maxX, width - 1);
+    maxY = (std::min)(maxY, height - 1);
+    if (minX > maxX || minY > maxY) {
+        window = OccupancyGrid();
+        return;
+    }
+
+    window = OccupancyGrid(maxX - minX + 1, maxY - minY + 1);
+    for (int chunkY = minY / chunkSize; chunkY <= maxY / chunkSize; ++chunkY) {
+        for (int chunkX = minX / chunkSize; chunkX <= maxX / chunkSize; ++chunkX) {
+            const int chunk = chunkY * chunksX + chunkX;
+            const ChunkState state = load(chunk);
+            if (state == ChunkState::Free)
+                continue;
+
+            // Part of the chunk inside the rectangle
+            const int fromX = (std::max)(minX, chunkX * chunkSize);
+            const int fromY = (std::max)(minY, chunkY * chunkSize);
+            const int toX = (std::min)(maxX, chunkX * chunkSize + chunkSize - 1);
+            const int toY = (std::min)(maxY, chunkY * chunkSize + chunkSize - 1);
+            if (state == ChunkState::Blocked) {
+                window.fillRect(fromX - minX, fromY - minY, toX - minX, toY - minY);
+                continue;
+            }
+            window.copyBlock(mixedChunks.find(chunk)->second.tiles, fromX - chunkX * chunkSize, fromY - chunkY * chunkSize,
+                fromX - minX, fromY - minY, toX - fromX + 1, toY - fromY + 1);
+        }
+    }
+}
+
+void ChunkedGrid::invalidate(int minX, int minY, int maxX, int maxY)
+{
+    minX = (std::max)(minX, 0);
+    minY = (std::max)(minY, 0);
+    maxX = (std::min)(maxX, width - 1);
+    maxY = (std::min)(maxY, height - 1);
+
+    for (int chunkY = minY / chunkSize; minX <= maxX && chunkY <= maxY / chunkSize; ++chunkY) {
+        for (int chunkX = minX / chunkSize; chunkX <= maxX / chunkSize; ++chunkX)
+            drop(chunkY * chunksX + chunkX);
+    }
+}
@@ -0,0 +1,72 @@
+#pragma once
+#include "OccupancyGrid.h"
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+// Occupancy of a map too large to keep as one grid. The map is cut into square
+// chunks, each generated only when one of its tiles is first read. A chunk that
+// turns out all free or all blocked is kept as that one state; the others keep
+// their bits until together they take more than maxBytes, when the least
+// recently read are dropped, to be generated again if they are read again.
+// Reads update that bookkeeping, so a ChunkedGrid serves one thread at a time.
+class ChunkedGrid {
+public:
+    static constexpr int chunkSize = 64; // tiles per side, a chunk row is one word
+
+    // Marks the blocked tiles of chunk (chunkX, chunkY) in tiles, a free grid
+    // whose (0, 0) is the chunk's top-left tile; chunks on the far edges of the
+    // map are cut to its size
+    using Generator = std::function<void(int chunkX, int chunkY, OccupancyGrid& tiles)>;
+
+private:
+    enum class ChunkState : unsigned char { Missing, Free, Blocked, Mixed };
+
+    struct MixedChunk {
+        OccupancyGrid tiles;
+        std::list<int>::iterator recent;
+    };
+
+    int width = 0;
+    int height = 0;
+    int chunksX = 0;
+    int chunksY = 0;
+    size_t maxBytes = 0;
+    size_t usedBytes = 0; // bits of the mixed chunks
+    size_t generatedCount = 0;
+    Generator generator;
+
+    std::vector<ChunkState> states; // per chunk, one byte whatever the chunk holds
+    std::unordered_map<int, MixedChunk> mixedChunks;
+    std::list<int> recentChunks; // mixed chunks, most recently read first
+
+    ChunkState load(int chunk); // generates the chunk if it is missing
+    void drop(int chunk);
+
+public:
+    ChunkedGrid(int width, int height, size_t maxBytes, Generator generator);
+    ~ChunkedGrid() = default;
+
+    ChunkedGrid(const ChunkedGrid&) = delete;
+    ChunkedGrid& operator=(const ChunkedGrid&) = delete;
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    int getChunksX() const { return chunksX; }
+    int getChunksY() const { return chunksY; }
+
+    // Tiles outside the map count as blocked
+    bool isBlocked(int x, int y);
+    // Fills window with the tiles of an inclusive rectangle clipped to the map,
+    // its top-left tile at (0, 0) of the window
+    void copyRect(int minX, int minY, int maxX, int maxY, OccupancyGrid& window);
+    // Forget every chunk overlapping an inclusive rectangle, e.g. after a
+    // collider there moved; they are generated again when next read
+    void invalidate(int minX, int minY, int maxX, int maxY);
+
+    size_t getMemoryBytes() const { return usedBytes + states.size(); }
+    size_t getMixedChunkCount() const { return mixedChunks.size(); }
+    size_t getGeneratedCount() const { return generatedCount; }
+};
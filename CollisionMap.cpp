@@ -1,246 +1,1466 @@
-#include "../Headers/CollisionMap.h"
-#include "../Headers/Transform.h"
-#include "../Headers/GameObject.h"
-#include "../Headers/Collider.h"
-#include "../Headers/BoxCollider.h"
-#include "../Headers/CircleCollider.h"
-#include "../Headers/Vector2.h"
-#include "../Headers/AIAgent.h"
-#include "../Headers/Engine.h"
-
-CollisionMap::CollisionMap() {
-	pathfinder_ = nullptr;
-}
-
-std::vector<std::shared_ptr<Vector2>> CollisionMap::GetPath(const std::shared_ptr<Vector2>& start, const std::shared_ptr<Vector2>& end) {
-	if (!pathfinder_) {
-		return std::vector<std::shared_ptr<Vector2>>();
-	}
-
-	// Convert world coordinates to tile indices
-	const float cellSize = smallestEntitySize_ / accuracy_;
-	if (cellSize <= 0.0f)
-		return {};
-
-	int xStart = static_cast<int>(std::floor((start->getX() - worldStartX_) / cellSize));
-	int yStart = static_cast<int>(std::floor((start->getY() - worldStartY_) / cellSize));
-	int xEnd = static_cast<int>(std::floor((end->getX() - worldStartX_) / cellSize));
-	int yEnd = static_cast<int>(std::floor((end->getY() - worldStartY_) / cellSize));
-
-	// Get actual map dimensions
-	const int mapWidth = static_cast<int>(std::ceil(worldWidth_));
-	const int mapHeight = static_cast<int>(std::ceil(worldHeight_));
-
-	if (mapWidth <= 0 || mapHeight <= 0)
-		return {};
-
-	xStart = ClampInt(xStart, 0, mapWidth - 1);
-	yStart = ClampInt(yStart, 0, mapHeight - 1);
-	xEnd = ClampInt(xEnd, 0, mapWidth - 1);
-	yEnd = ClampInt(yEnd, 0, mapHeight - 1);
-
-	std::vector<std::shared_ptr<AstarTile>> astarPath = pathfinder_->newPath(xStart, yStart, xEnd, yEnd);
-	std::vector<std::shared_ptr<Vector2>> path;
-
-
-	for (auto tile : astarPath) {
-		auto vec = std::make_shared<Vector2>();
-		// Convert tile coordinates back to world coordinates (CENTER of tile)
-		vec->setX(tile->getX() * cellSize + worldStartX_ + cellSize * 0.5f);
-		vec->setY(tile->getY() * cellSize + worldStartY_ + cellSize * 0.5f);
-		path.push_back(vec);
-	}
-
-	// Debug path with RenderSystem
-	Engine& engine = Engine::instance();
-	auto renderSystem = engine.GetSystem<RenderSystem>();
-	if (renderSystem) {
-		renderSystem->SetDebugPath(path, mapWidth, mapHeight, cellSize, worldStartX_, worldStartY_);
-	}
-
-	return path;
-}
-
-void CollisionMap::RefreshMap(std::list<std::shared_ptr<Collider>>& colliders) {
-	FindMapData(colliders);
-	tileMap_ = GenerateTileMap(colliders);
-
-	// Get actual tile dimensions
-	const int mapWidthInTiles = static_cast<int>(std::ceil(worldWidth_));
-	const int mapHeightInTiles = static_cast<int>(std::ceil(worldHeight_));
-
-	// Entity size in tiles should be 1 for simple pathfinding
-	// Or calculate based on actual agent size if you want larger agents
-	const int entitySizeInTiles = 1;
-
-	if (!pathfinder_) {
-		pathfinder_ = std::make_shared<Pathfinder>(
-			mapWidthInTiles,
-			mapHeightInTiles,
-			entitySizeInTiles,  // width in tiles
-			entitySizeInTiles   // height in tiles
-		);
-	}
-	pathfinder_->setTileMap(tileMap_);
-}
-
-std::vector<std::vector<std::shared_ptr<AstarTile>>> CollisionMap::GenerateTileMap(std::list<std::shared_ptr<Collider>>& colliders) {
-
-	const int mapWidth = static_cast<int>(std::ceil(worldWidth_));
-	const int mapHeight = static_cast<int>(std::ceil(worldHeight_));
-
-	const float cellSize = smallestEntitySize_ / accuracy_;
-	if (cellSize <= 0.0f) {
-		throw std::runtime_error("Invalid CollisionMap cell size");
-	}
-
-	// Initialize empty tile map
-	std::vector<std::vector<std::shared_ptr<AstarTile>>> tileMap;
-	tileMap.resize(mapWidth);
-	for (int i = 0; i < mapWidth; i++) {
-		tileMap[i].resize(mapHeight, nullptr);
-	}
-
-	for (int y = 0; y < mapHeight; y++) {
-		for (int x = 0; x < mapWidth; x++) {
-			tileMap[x][y] = std::make_shared<AstarTile>(x, y, false);
-		}
-	}
-
-	// Mark tiles with collisions
-	for (auto collider : colliders) {
-		auto gameObject = collider->GetGameObject();
-		if (!gameObject) continue;
-		auto& transform = gameObject->transform;
-		auto box = gameObject->GetComponent<BoxCollider>();
-		auto circle = gameObject->GetComponent<CircleCollider>();
-
-		if (auto agentComp = gameObject->GetComponent<AIAgent>()) {
-			continue; // skip AI agents
-		}
-
-		float startX = transform.GetWorldPosition().getX();
-		float startY = transform.GetWorldPosition().getY();
-		float endX = startX;
-		float endY = startY;
-		if (box) {
-			float halfWidth = box->GetWidth() * 0.5f;
-			float halfHeight = box->GetHeight() * 0.5f;
-			startX -= halfWidth;
-			startY -= halfHeight;
-			endX += halfWidth;
-			endY += halfHeight;
-		}
-		else if (circle) {
-			float radius = circle->GetRadius();
-			startX -= radius;
-			startY -= radius;
-			endX += radius;
-			endY += radius;
-		}
-		else {
-			continue; // skip invalid collider
-		}
-
-		// Convert world coordinates to tile indices
-		int tileStartX = static_cast<int>(std::floor((startX - worldStartX_) / cellSize));
-		int tileStartY = static_cast<int>(std::floor((startY - worldStartY_) / cellSize));
-		int tileEndX = static_cast<int>(std::floor((endX - worldStartX_) / cellSize));
-		int tileEndY = static_cast<int>(std::floor((endY - worldStartY_) / cellSize));
-
-		// Clamp to map bounds
-		tileStartX = (std::max)(0, (std::min)(tileStartX, mapWidth - 1));
-		tileStartY = (std::max)(0, (std::min)(tileStartY, mapHeight - 1));
-		tileEndX = (std::max)(0, (std::min)(tileEndX, mapWidth - 1));
-		tileEndY = (std::max)(0, (std::min)(tileEndY, mapHeight - 1));
-
-
-		// Mark tiles as having collision
-		for (int y = tileStartY; y <= tileEndY; y++) {
-			for (int x = tileStartX; x <= tileEndX; x++) {
-				if (tileMap[x][y]) {
-					tileMap[x][y]->setHasCollision(true);
-				}
-			}
-		}
-	}
-
-	return tileMap;
-}
-
-void CollisionMap::FindMapData(std::list<std::shared_ptr<Collider>>& colliders) {
-
-	// For each collider, determine the smallest entity size and world size
-	smallestEntitySize_ = 999999.0f;
-
-	float worldMinX = 999999.0f;
-	float worldMinY = 999999.0f;
-	float worldMaxX = std::numeric_limits<float>::lowest();
-	float worldMaxY = std::numeric_limits<float>::lowest();
-
-	bool foundAny = false;
-
-	for (const auto& collider : colliders) {
-		auto gameObject = collider->GetGameObject();
-		if (!gameObject) continue;
-
-		auto& transform = gameObject->transform;
-
-		auto box = gameObject->GetComponent<BoxCollider>();
-		auto circle = gameObject->GetComponent<CircleCollider>();
-
-		float startX = transform.GetWorldPosition().getX();
-		float startY = transform.GetWorldPosition().getY();
-		float endX = startX;
-		float endY = startY;
-
-		float entitySize;
-
-		if (box) {
-			entitySize = (std::min)(box->GetWidth(), box->GetHeight());
-			float halfWidth = box->GetWidth() * 0.5f;
-			float halfHeight = box->GetHeight() * 0.5f;
-			startX -= halfWidth;
-			startY -= halfHeight;
-			endX += halfWidth;
-			endY += halfHeight;
-		}
-		else if (circle) {
-			entitySize = circle->GetRadius() * 2.0f;
-			float radius = circle->GetRadius();
-			startX -= radius;
-			startY -= radius;
-			endX += radius;
-			endY += radius;
-		}
-		else {
-			continue; // skip invalid collider
-		}
-
-		foundAny = true;
-
-		smallestEntitySize_ = (std::min)(smallestEntitySize_, entitySize);
-
-		worldMinX = (std::min)(worldMinX, startX);
-		worldMinY = (std::min)(worldMinY, startY);
-		worldMaxX = (std::max)(worldMaxX, endX);
-		worldMaxY = (std::max)(worldMaxY, endY);
-	}
-
-	if (!foundAny) {
-		return;
-	}
-
-	worldStartX_ = worldMinX;
-	worldStartY_ = worldMinY;
-	worldEndX_ = worldMaxX;
-	worldEndY_ = worldMaxY;
-
-	float deltaX = std::abs(worldEndX_ - worldStartX_);
-	float deltaY = std::abs(worldEndY_ - worldStartY_);
-
-	if (smallestEntitySize_ < 1.0f) smallestEntitySize_ = 1.0f;
-
-	worldWidth_ = deltaX / (smallestEntitySize_ / accuracy_);
-	worldHeight_ = deltaY / (smallestEntitySize_ / accuracy_);
+#include "../Headers/CollisionMap.h"
+#include "../Headers/Transform.h"
+#include "../Headers/GameObject.h"
+#include "../Headers/Collider.h"
+#include "../Headers/BoxCollider.h"
+#include "../Headers/CircleCollider.h"
+#include "../Headers/Vector2.h"
+#include "../Headers/AIAgent.h"
+#include "../Headers/Engine.h"
+#include "../Headers/NavAsset.h"
+
+CollisionMap::CollisionMap() {
+	pathfinder_ = nullptr;
+}
+
+CollisionMap::~CollisionMap() {
+	// The futures wait for their builds, which stop within a few thousand tiles once cancelled
+	if (landmarkCancel_) {
+		landmarkCancel_->store(true);
+	}
+	CancelRebuild();
+}
+
+std::vector<std::shared_ptr<Vector2>> CollisionMap::GetPath(const std::shared_ptr<Vector2>& start, const std::shared_ptr<Vector2>& end, float agentSize) {
+	std::vector<Vector2> points;
+	if (!FindPath(*start, *end, points, agentSize)) {
+		return {};
+	}
+
+	std::vector<std::shared_ptr<Vector2>> path;
+	path.reserve(points.size());
+	for (const Vector2& point : points) {
+		path.push_back(std::make_shared<Vector2>(point));
+	}
+	if (drawDebugPaths_) {
+		DrawDebugPath(path);
+	}
+	return path;
+}
+
+bool CollisionMap::GetPath(const Vector2& start, const Vector2& end, std::vector<Vector2>& path, float agentSize) {
+	// Drawing would take a shared_ptr per waypoint, the shared_ptr overload draws
+	FindPath(start, end, path, agentSize);
+	return !path.empty();
+}
+
+bool CollisionMap::FindPath(const Vector2& start, const Vector2& end, std::vector<Vector2>& path, float agentSize) {
+	path.clear();
+	InstallMap();
+	if (!pathfinder_ && !chunkedMap_) {
+		return false;
+	}
+	InstallLandmarks();
+
+	// Convert world coordinates to tile indices
+	const float cellSize = smallestEntitySize_ / accuracy_;
+	if (cellSize <= 0.0f)
+		return false;
+
+	// Larger agents are placed by the top-left tile of their footprint
+	const int sizeClass = SizeClassOf(agentSize);
+	const float footprintOffset = (sizeClass - 1) * 0.5f;
+
+	int xStart = static_cast<int>(std::floor((start.getX() - worldStartX_) / cellSize - footprintOffset));
+	int yStart = static_cast<int>(std::floor((start.getY() - worldStartY_) / cellSize - footprintOffset));
+	int xEnd = static_cast<int>(std::floor((end.getX() - worldStartX_) / cellSize - footprintOffset));
+	int yEnd = static_cast<int>(std::floor((end.getY() - worldStartY_) / cellSize - footprintOffset));
+
+	// Get actual map dimensions
+	const int mapWidth = static_cast<int>(std::ceil(worldWidth_));
+	const int mapHeight = static_cast<int>(std::ceil(worldHeight_));
+
+	if (mapWidth <= 0 || mapHeight <= 0)
+		return false;
+
+	// Mesh and graph answer in microseconds, their paths are not cached
+	if (navigationMode_ == NavigationMode::NavMesh) {
+		NavMeshFor(sizeClass).findPath(start, end, path);
+		return true;
+	}
+	if (navigationMode_ == NavigationMode::VisibilityGraph) {
+		VisibilityGraphFor(sizeClass).findPath(start, end, path);
+		return true;
+	}
+
+	xStart = ClampInt(xStart, 0, mapWidth - 1);
+	yStart = ClampInt(yStart, 0, mapHeight - 1);
+	xEnd = ClampInt(xEnd, 0, mapWidth - 1);
+	yEnd = ClampInt(yEnd, 0, mapHeight - 1);
+
+	if (chunkedMap_) {
+		return FindChunkedPath(xStart, yStart, xEnd, yEnd, sizeClass, path);
+	}
+
+	// A search between disconnected regions would drain every reachable tile before failing
+	if (!ResolveGoal(xStart, yStart, xEnd, yEnd, sizeClass))
+		return false;
+
+	// Cache hits are read in place, so a repeated query copies nothing but the waypoints
+	std::vector<std::shared_ptr<AstarTile>> searchedPath;
+	const std::vector<std::shared_ptr<AstarTile>>* astarPath = pathCache_.find(xStart, yStart, xEnd, yEnd, sizeClass, mapVersion_);
+	if (!astarPath) {
+		// One clearance map serves every size class; the hierarchy only covers the one it was built for
+		pathfinder_->setEntitySize(sizeClass);
+		searchedPath = hierarchy_ && hierarchy_->getEntitySize() == sizeClass && searchOptions_.mode == SearchMode::Auto &&
+			searchOptions_.weight <= 1.0f && !NearbyClusters(xStart, yStart, xEnd, yEnd)
+			? hierarchy_->newPath(xStart, yStart, xEnd, yEnd)
+			: pathfinder_->newPath(xStart, yStart, xEnd, yEnd, searchOptions_);
+		pathCache_.insert(xStart, yStart, xEnd, yEnd, sizeClass, mapVersion_, searchedPath);
+		astarPath = &searchedPath;
+	}
+	ToWorldPath(*astarPath, sizeClass, path);
+	return true;
+}
+
+bool CollisionMap::NearbyClusters(int xStart, int yStart, int xEnd, int yEnd) const {
+	// A short query is cheap on the tiles and would lose the most taking an entrance of the hierarchy
+	const int clusterSize = hierarchy_->getClusterSize();
+	return std::abs(xStart / clusterSize - xEnd / clusterSize) <= 1 && std::abs(yStart / clusterSize - yEnd / clusterSize) <= 1;
+}
+
+void CollisionMap::DrawDebugPath(const std::vector<std::shared_ptr<Vector2>>& path) {
+	Engine& engine = Engine::instance();
+	auto renderSystem = engine.GetSystem<RenderSystem>();
+	if (renderSystem) {
+		const int mapWidth = static_cast<int>(std::ceil(worldWidth_));
+		const int mapHeight = static_cast<int>(std::ceil(worldHeight_));
+		renderSystem->SetDebugPath(path, mapWidth, mapHeight, smallestEntitySize_ / accuracy_, worldStartX_, worldStartY_);
+	}
+}
+
+std::vector<std::shared_ptr<Vector2>> CollisionMap::GetPath(const Vector2& start, const Vector2& end, std::shared_ptr<DStarLite>& planner, float agentSize) {
+	std::vector<Vector2> points;
+	if (!GetPath(start, end, planner, points, agentSize)) {
+		return {};
+	}
+
+	std::vector<std::shared_ptr<Vector2>> path;
+	path.reserve(points.size());
+	for (const Vector2& point : points) {
+		path.push_back(std::make_shared<Vector2>(point));
+	}
+	return path;
+}
+
+bool CollisionMap::GetPath(const Vector2& start, const Vector2& end, std::shared_ptr<DStarLite>& planner, std::vector<Vector2>& path, float agentSize) {
+	path.clear();
+	InstallMap();
+	const int sizeClass = SizeClassOf(agentSize);
+	int xStart = 0;
+	int yStart = 0;
+	int xEnd = 0;
+	int yEnd = 0;
+	if (!pathfinder_ || !WorldToTile(start, xStart, yStart, sizeClass) || !WorldToTile(end, xEnd, yEnd, sizeClass))
+		return false;
+	if (!ResolveGoal(xStart, yStart, xEnd, yEnd, sizeClass))
+		return false;
+
+	if (!planner || planner->getPathfinder() != pathfinder_ || planner->getEntitySize() != sizeClass) {
+		planner = std::make_shared<DStarLite>(pathfinder_, sizeClass);
+		planner->setMapVersion(mapVersion_);
+	}
+
+	// Only the latest diff is kept; a planner that missed a version starts over
+	if (planner->getMapVersion() != mapVersion_) {
+		if (changedTilesValid_ && planner->getMapVersion() + 1 == mapVersion_)
+			planner->tilesChanged(changedTiles_);
+		else
+			planner->reset();
+		planner->setMapVersion(mapVersion_);
+	}
+
+	std::vector<int> route;
+	if (!planner->plan(xStart, yStart, xEnd, yEnd, route))
+		return false;
+
+	pathfinder_->setEntitySize(sizeClass);
+	ToWorldPath(pathfinder_->smoothRoute(route), sizeClass, path);
+	return !path.empty();
+}
+
+unsigned CollisionMap::RequestPath(const Vector2& start, const Vector2& end, float agentSize, std::function<void(std::vector<std::shared_ptr<Vector2>>)> callback) {
+	return RequestPathInto(start, end, agentSize, [callback](const std::vector<Vector2>& points) {
+		std::vector<std::shared_ptr<Vector2>> path;
+		path.reserve(points.size());
+		for (const Vector2& point : points) {
+			path.push_back(std::make_shared<Vector2>(point));
+		}
+		callback(std::move(path));
+	});
+}
+
+unsigned CollisionMap::RequestPathInto(const Vector2& start, const Vector2& end, float agentSize, std::function<void(const std::vector<Vector2>&)> callback) {
+	InstallMap();
+	const int sizeClass = SizeClassOf(agentSize);
+	int xStart = 0;
+	int yStart = 0;
+	int xEnd = 0;
+	int yEnd = 0;
+	if (!pathfinder_ || !WorldToTile(start, xStart, yStart, sizeClass) || !WorldToTile(end, xEnd, yEnd, sizeClass))
+		return 0;
+
+	InstallLandmarks();
+	if (!pathRequests_) {
+		pathRequests_ = std::make_unique<PathRequestService>();
+		PublishMap();
+	}
+
+	if (!ResolveGoal(xStart, yStart, xEnd, yEnd, sizeClass)) {
+		return pathRequests_->answer({}, [callback](const std::vector<std::shared_ptr<AstarTile>>&) {
+			callback({});
+		});
+	}
+
+	// The map may be rebuilt with another origin or cell size before the result
+	// arrives, so the tile path is converted with the layout it was searched on
+	const unsigned version = mapVersion_;
+	const unsigned generation = searchGeneration_;
+	const float cellSize = smallestEntitySize_ / accuracy_;
+	const float originX = worldStartX_ + cellSize * sizeClass * 0.5f;
+	const float originY = worldStartY_ + cellSize * sizeClass * 0.5f;
+	auto convert = [this, callback, cellSize, originX, originY](const std::vector<std::shared_ptr<AstarTile>>& tilePath) {
+		// Every delivery converts into the same buffer, which keeps its capacity
+		deliveredPath_.clear();
+		for (const auto& tile : tilePath) {
+			deliveredPath_.emplace_back(tile->getX() * cellSize + originX, tile->getY() * cellSize + originY);
+		}
+		callback(deliveredPath_);
+	};
+
+	// A cached path is handed back with the next delivery, like any other result
+	const std::vector<std::shared_ptr<AstarTile>>* cachedPath = pathCache_.find(xStart, yStart, xEnd, yEnd, sizeClass, mapVersion_);
+	if (cachedPath) {
+		return pathRequests_->answer(*cachedPath, convert);
+	}
+
+	// Searched with options or a map that changed since is not what the cache would search now
+	return pathRequests_->request(xStart, yStart, xEnd, yEnd, sizeClass, searchOptions_,
+		[this, convert, version, generation, xStart, yStart, xEnd, yEnd, sizeClass](const std::vector<std::shared_ptr<AstarTile>>& tilePath) {
+			if (version == mapVersion_ && generation == searchGeneration_) {
+				pathCache_.insert(xStart, yStart, xEnd, yEnd, sizeClass, version, tilePath);
+			}
+			convert(tilePath);
+		});
+}
+
+void CollisionMap::CancelPathRequest(unsigned request) {
+	if (pathRequests_) {
+		pathRequests_->cancel(request);
+	}
+}
+
+bool CollisionMap::IsPathRequestPending(unsigned request) const {
+	return pathRequests_ && pathRequests_->isPending(request);
+}
+
+void CollisionMap::SetSearchOptions(const SearchOptions& options) {
+	searchOptions_ = options;
+	// Cached paths were found with the old search, and so are those still being searched
+	pathCache_.clear();
+	searchGeneration_++;
+}
+
+size_t CollisionMap::DeliverPathResults(size_t maxResults) {
+	InstallMap();
+	InstallLandmarks();
+	return pathRequests_ ? pathRequests_->deliver(maxResults) : 0;
+}
+
+void CollisionMap::SetRedirectUnreachable(bool redirect, int maxRadius) {
+	redirectUnreachable_ = redirect;
+	redirectRadius_ = (std::max)(0, maxRadius);
+	// Cached failures may now have a redirected answer
+	pathCache_.clear();
+	searchGeneration_++;
+}
+
+const ComponentLabels& CollisionMap::ComponentsFor(int sizeClass) {
+	if (components_.size() <= static_cast<size_t>(sizeClass)) {
+		components_.resize(sizeClass + 1);
+	}
+
+	std::shared_ptr<const ComponentLabels>& components = components_[sizeClass];
+	if (!components || !components->covers(*BaseGrid(), sizeClass)) {
+		components = std::make_shared<const ComponentLabels>(*BaseGrid(), sizeClass);
+	}
+	return *components;
+}
+
+const NavMesh& CollisionMap::NavMeshFor(int sizeClass) {
+	if (navMeshes_.size() <= static_cast<size_t>(sizeClass)) {
+		navMeshes_.resize(sizeClass + 1);
+	}
+
+	// Agents of a size class are as wide as their footprint on the tile map
+	std::shared_ptr<const NavMesh>& navMesh = navMeshes_[sizeClass];
+	if (!navMesh) {
+		float minX, minY, maxX, maxY;
+		GetNavBounds(minX, minY, maxX, maxY);
+		navMesh = std::make_shared<const NavMesh>(NavObstacles(), minX, minY, maxX, maxY, sizeClass * smallestEntitySize_ / accuracy_ * 0.5f);
+	}
+	return *navMesh;
+}
+
+const VisibilityGraph& CollisionMap::VisibilityGraphFor(int sizeClass) {
+	if (visibilityGraphs_.size() <= static_cast<size_t>(sizeClass)) {
+		visibilityGraphs_.resize(sizeClass + 1);
+	}
+
+	std::shared_ptr<const VisibilityGraph>& graph = visibilityGraphs_[sizeClass];
+	if (!graph) {
+		float minX, minY, maxX, maxY;
+		GetNavBounds(minX, minY, maxX, maxY);
+		graph = std::make_shared<const VisibilityGraph>(NavObstacles(), minX, minY, maxX, maxY, sizeClass * smallestEntitySize_ / accuracy_ * 0.5f);
+	}
+	return *graph;
+}
+
+std::vector<NavObstacle> CollisionMap::NavObstacles() const {
+	if (!staticLayer_)
+		return obstacles_;
+
+	std::vector<NavObstacle> obstacles = staticLayer_->obstacles;
+	obstacles.insert(obstacles.end(), obstacles_.begin(), obstacles_.end());
+	return obstacles;
+}
+
+void CollisionMap::GetNavBounds(float& minX, float& minY, float& maxX, float& maxY) const {
+	const float cellSize = smallestEntitySize_ / accuracy_;
+	minX = worldStartX_;
+	minY = worldStartY_;
+	maxX = worldStartX_ + std::ceil(worldWidth_) * cellSize;
+	maxY = worldStartY_ + std::ceil(worldHeight_) * cellSize;
+}
+
+bool CollisionMap::ResolveGoal(int xStart, int yStart, int& xEnd, int& yEnd, int sizeClass) {
+	const ComponentLabels& components = ComponentsFor(sizeClass);
+	const int startComponent = components.componentAt(xStart, yStart);
+
+	// An agent pushed into an obstacle still gets a search, the pathfinder copes with that start
+	if (startComponent < 0 || components.componentAt(xEnd, yEnd) == startComponent)
+		return true;
+	if (!redirectUnreachable_)
+		return false;
+	return components.nearestTile(startComponent, xEnd, yEnd, redirectRadius_, xEnd, yEnd);
+}
+
+void CollisionMap::PublishMap() {
+	auto snapshot = std::make_shared<Pathfinder>(pathfinder_->getGrid());
+	snapshot->setLandmarks(pathfinder_->getLandmarks());
+	snapshot->setStaticLayer(pathfinder_->getStaticLayer());
+	pathRequests_->setMap(std::move(snapshot), mapVersion_);
+}
+
+void CollisionMap::SetLandmarks(int maxLandmarks, size_t maxBytes) {
+	landmarkCount_ = (std::max)(0, maxLandmarks);
+	landmarkMaxBytes_ = maxBytes;
+	if (!pathfinder_)
+		return;
+
+	if (landmarkCount_ > 0) {
+		BuildLandmarks();
+		return;
+	}
+
+	CancelLandmarks();
+	pathfinder_->setLandmarks(nullptr);
+	if (pathRequests_) {
+		PublishMap();
+	}
+}
+
+void CollisionMap::CancelLandmarks() {
+	if (landmarkBuild_.valid()) {
+		landmarkCancel_->store(true);
+		landmarkStale_ = true;
+	}
+}
+
+void CollisionMap::BuildLandmarks() {
+	// A build for an older map is of no use any more. Replacing its future would
+	// wait for it here; instead it is cancelled, and InstallLandmarks starts one
+	// build for the map of that moment once it has stopped.
+	if (landmarkBuild_.valid()) {
+		CancelLandmarks();
+		return;
+	}
+	landmarkStale_ = false;
+	auto cancel = std::make_shared<std::atomic<bool>>(false);
+	landmarkCancel_ = cancel;
+
+	landmarkBuild_ = std::async(std::launch::async,
+		[grid = BaseGrid(), count = landmarkCount_, maxBytes = landmarkMaxBytes_, cancel]() {
+			return std::make_shared<const LandmarkTable>(grid, 1, count, maxBytes, cancel.get());
+		});
+}
+
+void CollisionMap::InstallLandmarks() {
+	if (!landmarkBuild_.valid() || landmarkBuild_.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+		return;
+
+	std::shared_ptr<const LandmarkTable> landmarks = landmarkBuild_.get();
+	if (landmarkStale_) {
+		// Start over for the current map, unless landmarks were turned off or it has a table already
+		landmarkStale_ = false;
+		if (landmarkCount_ > 0 && pathfinder_ &&
+			!(pathfinder_->getLandmarks() && pathfinder_->getLandmarks()->covers(*BaseGrid(), 1))) {
+			BuildLandmarks();
+		}
+		return;
+	}
+	if (!pathfinder_ || !landmarks->covers(*BaseGrid(), 1))
+		return;
+
+	// Same map, better heuristic: cached paths and the map version stay valid
+	pathfinder_->setLandmarks(std::move(landmarks));
+	if (pathRequests_) {
+		PublishMap();
+	}
+}
+
+void CollisionMap::SetStaticColliders(std::list<std::shared_ptr<Collider>>& colliders) {
+	staticColliders_ = colliders;
+	staticExtent_ = MapExtent();
+	MeasureColliders(staticColliders_, staticExtent_);
+
+	// Baked by the next refresh, at the layout the dynamic colliders give
+	staticLayerStale_ = true;
+}
+
+std::shared_ptr<CollisionMap::StaticLayer> CollisionMap::BakeStaticLayer() {
+	staticLayerStale_ = false;
+	if (staticColliders_.empty())
+		return nullptr;
+
+	auto layer = std::make_shared<StaticLayer>();
+	std::unordered_map<const Collider*, TileRect> footprints;
+	layer->occupancy = GenerateOccupancy(staticColliders_, footprints);
+	layer->obstacles = GatherObstacles(staticColliders_);
+	return layer;
+}
+
+std::shared_ptr<const NavGrid> CollisionMap::BaseGrid() const {
+	return staticLayer_ ? staticLayer_->grid : pathfinder_->getGrid();
+}
+
+CollisionMap::MapLayout CollisionMap::GetLayout() const {
+	return MapLayout{ worldStartX_, worldStartY_, worldEndX_, worldEndY_, worldWidth_, worldHeight_, smallestEntitySize_ };
+}
+
+void CollisionMap::SetLayout(const MapLayout& layout) {
+	worldStartX_ = layout.worldStartX;
+	worldStartY_ = layout.worldStartY;
+	worldEndX_ = layout.worldEndX;
+	worldEndY_ = layout.worldEndY;
+	worldWidth_ = layout.worldWidth;
+	worldHeight_ = layout.worldHeight;
+	smallestEntitySize_ = layout.smallestEntitySize;
+}
+
+void CollisionMap::StartRebuild(std::list<std::shared_ptr<Collider>>& colliders, const MapLayout& previous) {
+	if (smallestEntitySize_ / accuracy_ <= 0.0f) {
+		throw std::runtime_error("Invalid CollisionMap cell size");
+	}
+
+	// Colliders are only read here, on the calling thread; the worker gets their tile rectangles
+	auto build = std::make_shared<MapBuild>();
+	build->layout = GetLayout();
+	staticLayerStale_ = false;
+	if (!staticColliders_.empty()) {
+		build->staticLayer = std::make_shared<StaticLayer>();
+		build->staticLayer->obstacles = GatherObstacles(staticColliders_);
+		for (const auto& collider : staticColliders_) {
+			TileRect footprint;
+			if (FootprintOf(*collider, footprint)) {
+				build->staticFootprints.push_back(footprint);
+			}
+		}
+	}
+	for (const auto& collider : colliders) {
+		TileRect footprint;
+		if (FootprintOf(*collider, footprint)) {
+			build->footprints[collider.get()] = footprint;
+		}
+	}
+	build->obstacles = GatherObstacles(colliders);
+
+	// Queries keep converting positions for the map they search until the swap
+	SetLayout(previous);
+
+	std::vector<int> sizeClasses;
+	for (const auto& components : components_) {
+		if (components) {
+			sizeClasses.push_back(components->getEntitySize());
+		}
+	}
+
+	// A build this one supersedes is left to stop on its own
+	CancelRebuild();
+	auto cancel = std::make_shared<std::atomic<bool>>(false);
+	mapBuildCancel_ = cancel;
+	mapBuild_ = std::async(std::launch::async,
+		[build, cancel, sizeClasses, clusterSize = clusterSize_, hierarchyMinTiles = hierarchyMinTiles_]() -> std::shared_ptr<MapBuild> {
+			const int width = build->layout.worldWidth;
+			const int height = build->layout.worldHeight;
+			if (build->staticLayer) {
+				build->staticLayer->occupancy = OccupancyGrid(width, height);
+				for (const TileRect& footprint : build->staticFootprints) {
+					build->staticLayer->occupancy.fillRect(footprint.minX, footprint.minY, footprint.maxX, footprint.maxY);
+				}
+			}
+			build->occupancy = build->staticLayer ? build->staticLayer->occupancy : OccupancyGrid(width, height);
+			for (const auto& footprint : build->footprints) {
+				build->occupancy.fillRect(footprint.second.minX, footprint.second.minY, footprint.second.maxX, footprint.second.maxY);
+			}
+			if (cancel->load()) {
+				return nullptr;
+			}
+
+			build->pathfinder = std::make_shared<Pathfinder>(width, height);
+			build->pathfinder->setOccupancy(build->occupancy);
+			build->pathfinder->setEntitySize(1);
+			if (build->staticLayer) {
+				build->staticLayer->grid = std::make_shared<const NavGrid>(build->staticLayer->occupancy, std::vector<int>());
+				build->pathfinder->setStaticLayer(build->staticLayer->grid);
+			}
+			const NavGrid& baseGrid = build->staticLayer ? *build->staticLayer->grid : *build->pathfinder->getGrid();
+
+			if (cancel->load()) {
+				return nullptr;
+			}
+
+			if (width * height >= hierarchyMinTiles) {
+				build->hierarchy = std::make_shared<HierarchicalMap>(build->pathfinder, clusterSize);
+				build->hierarchy->build();
+			}
+			for (int sizeClass : sizeClasses) {
+				if (cancel->load()) {
+					return nullptr;
+				}
+				if (build->components.size() <= static_cast<size_t>(sizeClass)) {
+					build->components.resize(sizeClass + 1);
+				}
+				build->components[sizeClass] = std::make_shared<const ComponentLabels>(baseGrid, sizeClass);
+			}
+			return build;
+		});
+}
+
+void CollisionMap::CancelRebuild() {
+	if (mapBuild_.valid()) {
+		mapBuildCancel_->store(true);
+		retiredMapBuilds_.push_back(std::move(mapBuild_));
+	}
+	mapBuild_ = {};
+	mapBuildCancel_ = nullptr;
+	pendingColliders_.clear();
+	refreshPending_ = false;
+}
+
+void CollisionMap::InstallMap() {
+	// Cancelled builds are only let go of once they have stopped, so no frame waits on one
+	retiredMapBuilds_.erase(std::remove_if(retiredMapBuilds_.begin(), retiredMapBuilds_.end(),
+		[](const std::future<std::shared_ptr<MapBuild>>& retired) {
+			return retired.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+		}), retiredMapBuilds_.end());
+
+	if (!mapBuild_.valid() || mapBuild_.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+		return;
+
+	std::shared_ptr<MapBuild> build = mapBuild_.get();
+	mapBuildCancel_ = nullptr;
+	SetLayout(build->layout);
+	occupancy_ = std::move(build->occupancy);
+	footprints_ = std::move(build->footprints);
+	obstacles_ = std::move(build->obstacles);
+	staticLayer_ = std::move(build->staticLayer);
+	navMeshes_.clear();
+	visibilityGraphs_.clear();
+
+	// The old map stays alive for as long as a worker or a planner still holds it
+	pathfinder_ = std::move(build->pathfinder);
+	hierarchy_ = std::move(build->hierarchy);
+	components_ = std::move(build->components);
+
+	mapVersion_++;
+	changedTiles_.clear();
+	changedTilesValid_ = false;
+	flowFields_.clear();
+
+	if (landmarkCount_ > 0) {
+		BuildLandmarks();
+	}
+	if (pathRequests_) {
+		PublishMap();
+	}
+
+	// Catch up with what moved while the build ran
+	if (refreshPending_) {
+		std::list<std::shared_ptr<Collider>> colliders = std::move(pendingColliders_);
+		pendingColliders_.clear();
+		refreshPending_ = false;
+		RefreshMap(colliders);
+	}
+}
+
+bool CollisionMap::BakeNavigation(std::list<std::shared_ptr<Collider>>& colliders, const std::string& path) {
+	if (chunkedMaxBytes_ > 0) {
+		return false;
+	}
+
+	// Bake the map for these colliders as it stands, not one still on its way; its catch-up is not deferred either
+	const bool background = backgroundRebuild_;
+	backgroundRebuild_ = false;
+	if (mapBuild_.valid()) {
+		mapBuild_.wait();
+		InstallMap();
+	}
+	RefreshMap(colliders);
+	backgroundRebuild_ = background;
+	if (!pathfinder_) {
+		return false;
+	}
+	// A build superseded while it ran is followed by one for this map
+	while (landmarkBuild_.valid()) {
+		landmarkBuild_.wait();
+		InstallLandmarks();
+	}
+
+	std::unordered_map<const Collider*, TileRect> footprints;
+	NavAsset::Contents contents;
+	contents.layout.sceneHash = SceneHash(colliders, footprints);
+	contents.layout.worldStartX = worldStartX_;
+	contents.layout.worldStartY = worldStartY_;
+	contents.layout.worldEndX = worldEndX_;
+	contents.layout.worldEndY = worldEndY_;
+	contents.layout.smallestEntitySize = smallestEntitySize_;
+	contents.layout.accuracy = accuracy_;
+	contents.layout.worldWidth = worldWidth_;
+	contents.layout.worldHeight = worldHeight_;
+	contents.layout.tilesX = occupancy_.getWidth();
+	contents.layout.tilesY = occupancy_.getHeight();
+
+	contents.occupancy = &occupancy_;
+	contents.grid = pathfinder_->getGrid().get();
+	if (staticLayer_) {
+		contents.staticOccupancy = &staticLayer_->occupancy;
+		contents.staticGrid = staticLayer_->grid.get();
+	}
+	contents.components = &ComponentsFor(1);
+	contents.hierarchy = hierarchy_.get();
+	const std::shared_ptr<const LandmarkTable>& landmarks = pathfinder_->getLandmarks();
+	if (landmarks && landmarks->covers(*BaseGrid(), 1)) {
+		contents.landmarks = landmarks.get();
+	}
+	return NavAsset::write(path, contents);
+}
+
+bool CollisionMap::LoadNavigation(std::list<std::shared_ptr<Collider>>& colliders, const std::string& path) {
+	// Whatever a rebuild in flight would install is replaced here
+	CancelRebuild();
+
+	const MapLayout previousLayout = GetLayout();
+	FindMapData(colliders);
+	const int mapWidthInTiles = static_cast<int>(std::ceil(worldWidth_));
+	const int mapHeightInTiles = static_cast<int>(std::ceil(worldHeight_));
+
+	// A file baked for other colliders or another layout would be a wrong map, not a slow one
+	NavAsset asset;
+	std::unordered_map<const Collider*, TileRect> footprints;
+	bool fits = chunkedMaxBytes_ == 0 && asset.open(path);
+	if (fits) {
+		const NavAsset::Layout& layout = asset.getLayout();
+		fits = layout.worldStartX == worldStartX_ && layout.worldStartY == worldStartY_ && layout.worldEndX == worldEndX_ &&
+			layout.worldEndY == worldEndY_ && layout.smallestEntitySize == smallestEntitySize_ && layout.accuracy == accuracy_ &&
+			layout.worldWidth == worldWidth_ && layout.worldHeight == worldHeight_ &&
+			layout.tilesX == mapWidthInTiles && layout.tilesY == mapHeightInTiles &&
+			layout.sceneHash == SceneHash(colliders, footprints);
+	}
+
+	OccupancyGrid occupancy;
+	std::shared_ptr<const NavGrid> grid;
+	std::shared_ptr<StaticLayer> staticLayer;
+	if (fits) {
+		grid = asset.readGrid();
+		fits = grid && asset.readOccupancy(occupancy);
+	}
+	if (fits && !staticColliders_.empty()) {
+		staticLayer = std::make_shared<StaticLayer>();
+		staticLayer->grid = asset.readStaticGrid();
+		fits = staticLayer->grid && asset.readStaticOccupancy(staticLayer->occupancy);
+	}
+	if (!fits) {
+		SetLayout(previousLayout);
+		RefreshMap(colliders);
+		return false;
+	}
+
+	occupancy_ = std::move(occupancy);
+	footprints_ = std::move(footprints);
+	obstacles_ = GatherObstacles(colliders);
+	if (staticLayer) {
+		staticLayer->obstacles = GatherObstacles(staticColliders_);
+	}
+	staticLayer_ = staticLayer;
+	staticLayerStale_ = false;
+	navMeshes_.clear();
+	visibilityGraphs_.clear();
+
+	pathfinder_ = std::make_shared<Pathfinder>(grid);
+	pathfinder_->setStaticLayer(staticLayer_ ? staticLayer_->grid : nullptr);
+	pathfinder_->setEntitySize(1);
+
+	if (mapWidthInTiles * mapHeightInTiles >= hierarchyMinTiles_) {
+		hierarchy_ = std::make_shared<HierarchicalMap>(pathfinder_, clusterSize_);
+		if (!asset.readHierarchy(*hierarchy_)) {
+			hierarchy_->build();
+		}
+	}
+	else {
+		hierarchy_ = nullptr;
+	}
+
+	// Other size classes are labelled again on first use
+	components_.clear();
+	std::shared_ptr<const ComponentLabels> components = asset.readComponents(*BaseGrid());
+	if (components && components->getEntitySize() == 1) {
+		components_.resize(2);
+		components_[1] = std::move(components);
+	}
+
+	CancelLandmarks();
+	if (landmarkCount_ > 0) {
+		std::shared_ptr<const LandmarkTable> landmarks = asset.readLandmarks(*BaseGrid());
+		if (landmarks && landmarks->covers(*BaseGrid(), 1)) {
+			pathfinder_->setLandmarks(std::move(landmarks));
+		}
+		else {
+			BuildLandmarks();
+		}
+	}
+
+	mapVersion_++;
+	changedTiles_.clear();
+	changedTilesValid_ = false;
+	flowFields_.clear();
+
+	if (pathRequests_) {
+		PublishMap();
+	}
+	return true;
+}
+
+void CollisionMap::ToWorldPath(const std::vector<std::shared_ptr<AstarTile>>& tilePath, int sizeClass, std::vector<Vector2>& path) const {
+	const float cellSize = smallestEntitySize_ / accuracy_;
+	const float originX = worldStartX_ + cellSize * sizeClass * 0.5f;
+	const float originY = worldStartY_ + cellSize * sizeClass * 0.5f;
+
+	path.clear();
+	for (const auto& tile : tilePath) {
+		path.emplace_back(tile->getX() * cellSize + originX, tile->getY() * cellSize + originY);
+	}
+}
+
+std::vector<std::shared_ptr<Vector2>> CollisionMap::ToWorldPath(const std::vector<std::shared_ptr<AstarTile>>& tilePath, int sizeClass) const {
+	const float cellSize = smallestEntitySize_ / accuracy_;
+	std::vector<std::shared_ptr<Vector2>> path;
+	path.reserve(tilePath.size());
+
+	for (const auto& tile : tilePath) {
+		auto vec = std::make_shared<Vector2>();
+		// Convert tile coordinates back to world coordinates (CENTER of the footprint)
+		vec->setX(tile->getX() * cellSize + worldStartX_ + cellSize * sizeClass * 0.5f);
+		vec->setY(tile->getY() * cellSize + worldStartY_ + cellSize * sizeClass * 0.5f);
+		path.push_back(vec);
+	}
+	return path;
+}
+
+std::shared_ptr<const FlowField> CollisionMap::GetFlowField(const Vector2& goal, float agentSize) {
+	const int sizeClass = SizeClassOf(agentSize);
+	int xGoal = 0;
+	int yGoal = 0;
+	if (!pathfinder_ || !WorldToTile(goal, xGoal, yGoal, sizeClass))
+		return nullptr;
+
+	for (auto it = flowFields_.begin(); it != flowFields_.end(); ++it) {
+		auto field = *it;
+		if (field->getGoalX() == xGoal && field->getGoalY() == yGoal && field->getEntitySize() == sizeClass &&
+			field->getMapVersion() == mapVersion_) {
+			flowFields_.splice(flowFields_.begin(), flowFields_, it);
+			return field;
+		}
+	}
+
+	// One reverse pass from the goal serves every agent of this size heading there
+	pathfinder_->setEntitySize(sizeClass);
+	auto field = std::make_shared<FlowField>(*pathfinder_, xGoal, yGoal, mapVersion_);
+	flowFields_.push_front(field);
+	while (flowFields_.size() > flowFieldCapacity_) {
+		flowFields_.pop_back();
+	}
+	return field;
+}
+
+bool CollisionMap::GetFlowDirection(const Vector2& position, const Vector2& goal, Vector2& direction, float agentSize) {
+	auto field = GetFlowField(goal, agentSize);
+	if (!field)
+		return false;
+
+	const int sizeClass = field->getEntitySize();
+	int x = 0;
+	int y = 0;
+	int dx = 0;
+	int dy = 0;
+	if (!WorldToTile(position, x, y, sizeClass) || !field->getDirection(x, y, dx, dy))
+		return false;
+
+	// Aim for the centre of the next footprint so agents do not clip corners
+	const float cellSize = smallestEntitySize_ / accuracy_;
+	Vector2 next;
+	next.setX((x + dx) * cellSize + worldStartX_ + cellSize * sizeClass * 0.5f);
+	next.setY((y + dy) * cellSize + worldStartY_ + cellSize * sizeClass * 0.5f);
+
+	Vector2 toNext = next - position;
+	if (toNext.length() < 0.0001f)
+		return false;
+
+	direction = toNext.normalized();
+	return true;
+}
+
+void CollisionMap::RefreshMap(std::list<std::shared_ptr<Collider>>& colliders) {
+	// A rebuild in flight covers the colliders as they were when it started, these are refreshed after the swap
+	InstallMap();
+	InstallLandmarks();
+	if (mapBuild_.valid()) {
+		pendingColliders_ = colliders;
+		refreshPending_ = true;
+		return;
+	}
+
+	const MapLayout previousLayout = GetLayout();
+	const float oldStartX = worldStartX_;
+	const float oldStartY = worldStartY_;
+	const float oldCellSize = smallestEntitySize_ / accuracy_;
+	const float oldWidth = worldWidth_;
+	const float oldHeight = worldHeight_;
+
+	FindMapData(colliders);
+
+	// Get actual tile dimensions
+	const int mapWidthInTiles = static_cast<int>(std::ceil(worldWidth_));
+	const int mapHeightInTiles = static_cast<int>(std::ceil(worldHeight_));
+
+	// While the tiles stay where they were, only the footprints that changed are drawn again
+	const bool mapBuilt = chunkedMaxBytes_ > 0
+		? chunkedMap_ && chunkedMap_->getWidth() == mapWidthInTiles && chunkedMap_->getHeight() == mapHeightInTiles
+		: pathfinder_ && occupancy_.getWidth() == mapWidthInTiles && occupancy_.getHeight() == mapHeightInTiles;
+	const bool sameLayout = mapBuilt && !staticLayerStale_ && oldStartX == worldStartX_ && oldStartY == worldStartY_ &&
+		oldCellSize == smallestEntitySize_ / accuracy_;
+
+	if (!sameLayout && backgroundRebuild_ && chunkedMaxBytes_ == 0) {
+		StartRebuild(colliders, previousLayout);
+		return;
+	}
+
+	// Meshes and graphs follow the colliders themselves, which can move without changing a tile
+	std::vector<NavObstacle> obstacles = GatherObstacles(colliders);
+	if (!sameLayout || obstacles != obstacles_ || oldStartX != worldStartX_ || oldStartY != worldStartY_ || oldWidth != worldWidth_ ||
+		oldHeight != worldHeight_ || oldCellSize != smallestEntitySize_ / accuracy_) {
+		obstacles_ = std::move(obstacles);
+		navMeshes_.clear();
+		visibilityGraphs_.clear();
+	}
+
+	// Chunks are drawn when a search first reads them, not here
+	if (chunkedMaxBytes_ > 0) {
+		RefreshChunks(colliders, sameLayout);
+		return;
+	}
+
+	std::vector<int> changedTiles;
+	if (sameLayout) {
+		UpdateOccupancy(colliders, changedTiles);
+
+		// Nothing moved: keep the current map, its version and every cached path
+		if (changedTiles.empty()) {
+			return;
+		}
+	}
+	else {
+		// The static layer is drawn once per layout, the dynamic colliders go on top of it
+		std::shared_ptr<StaticLayer> staticLayer = BakeStaticLayer();
+		if (staticLayer) {
+			staticLayer->grid = std::make_shared<const NavGrid>(staticLayer->occupancy, std::vector<int>());
+		}
+		staticLayer_ = staticLayer;
+		occupancy_ = GenerateOccupancy(colliders, footprints_, staticLayer_ ? &staticLayer_->occupancy : nullptr);
+	}
+
+	mapVersion_++;
+	changedTiles_ = std::move(changedTiles);
+	changedTilesValid_ = sameLayout;
+	flowFields_.clear();
+
+	if (!pathfinder_) {
+		pathfinder_ = std::make_shared<Pathfinder>(mapWidthInTiles, mapHeightInTiles);
+	}
+	if (changedTilesValid_) {
+		// Clearance is only recomputed up and left of the changed tiles
+		pathfinder_->updateOccupancy(occupancy_, changedTiles_);
+	}
+	else {
+		pathfinder_->setOccupancy(occupancy_);
+		pathfinder_->setStaticLayer(staticLayer_ ? staticLayer_->grid : nullptr);
+	}
+	pathfinder_->setEntitySize(1);
+
+	// Labels and landmarks of the static layer hold for whatever is drawn over it
+	const bool keepBaseData = staticLayer_ && changedTilesValid_;
+
+	// Region labels follow the map, an edit only refloods the regions it may have split
+	for (auto& components : components_) {
+		if (!components || keepBaseData)
+			continue;
+		components = changedTilesValid_
+			? std::make_shared<const ComponentLabels>(*pathfinder_->getGrid(), *components, changedTiles_)
+			: std::make_shared<const ComponentLabels>(*BaseGrid(), components->getEntitySize());
+	}
+
+	// The old table bounds the old map; searches go without until the new one is built
+	if (!keepBaseData) {
+		pathfinder_->setLandmarks(nullptr);
+		if (landmarkCount_ > 0) {
+			BuildLandmarks();
+		}
+	}
+
+	// Large maps get a cluster hierarchy, so a query only pays for the clusters it crosses
+	if (mapWidthInTiles * mapHeightInTiles >= hierarchyMinTiles_) {
+		if (hierarchy_ && changedTilesValid_) {
+			// Only borders and clusters the edit touched are worked out again
+			hierarchy_->update(changedTiles_);
+		}
+		else {
+			if (!hierarchy_) {
+				hierarchy_ = std::make_shared<HierarchicalMap>(pathfinder_, clusterSize_);
+			}
+			hierarchy_->build();
+		}
+	}
+	else {
+		hierarchy_ = nullptr;
+	}
+
+	// Workers share the new grid, queued requests keep the one they were made on
+	if (pathRequests_) {
+		PublishMap();
+	}
+}
+
+void CollisionMap::SetChunkedMap(size_t maxBytes) {
+	// Drop a rebuild in flight without waiting for it, the next refresh starts over in the chosen form
+	CancelRebuild();
+	CancelLandmarks();
+
+	chunkedMaxBytes_ = maxBytes;
+	chunkPortals_ = nullptr;
+	chunkedMap_ = nullptr;
+	chunkWindow_ = nullptr;
+	chunkFootprints_.clear();
+	pathfinder_ = nullptr;
+	hierarchy_ = nullptr;
+	components_.clear();
+	staticLayer_ = nullptr;
+	occupancy_ = OccupancyGrid();
+	footprints_.clear();
+	flowFields_.clear();
+	pathCache_.clear();
+	searchGeneration_++;
+}
+
+void CollisionMap::RefreshChunks(std::list<std::shared_ptr<Collider>>& colliders, bool sameLayout) {
+	std::vector<TileRect> dirty;
+	if (!sameLayout) {
+		staticLayerStale_ = false;
+		staticFootprints_.clear();
+		for (const auto& collider : staticColliders_) {
+			TileRect footprint;
+			if (FootprintOf(*collider, footprint)) {
+				staticFootprints_.push_back(footprint);
+			}
+		}
+
+		footprints_.clear();
+		UpdateFootprints(colliders, dirty);
+		chunkedMap_ = std::make_unique<ChunkedGrid>(static_cast<int>(std::ceil(worldWidth_)), static_cast<int>(std::ceil(worldHeight_)),
+			chunkedMaxBytes_, [this](int chunkX, int chunkY, OccupancyGrid& tiles) {
+				auto bucket = chunkFootprints_.find(chunkY * chunkedMap_->getChunksX() + chunkX);
+				if (bucket == chunkFootprints_.end())
+					return;
+				const int x = chunkX * ChunkedGrid::chunkSize;
+				const int y = chunkY * ChunkedGrid::chunkSize;
+				for (const TileRect& footprint : bucket->second) {
+					tiles.fillRect(footprint.minX - x, footprint.minY - y, footprint.maxX - x, footprint.maxY - y);
+				}
+			});
+		chunkPortals_ = std::make_unique<ChunkPortals>(*chunkedMap_, chunkedMaxBytes_);
+	}
+	else {
+		UpdateFootprints(colliders, dirty);
+
+		// Nothing moved: keep the chunks, the version and every cached path
+		if (dirty.empty()) {
+			return;
+		}
+		for (const TileRect& rect : dirty) {
+			chunkedMap_->invalidate(rect.minX, rect.minY, rect.maxX, rect.maxY);
+			chunkPortals_->invalidate(rect.minX, rect.minY, rect.maxX, rect.maxY);
+		}
+	}
+	BucketFootprints();
+
+	mapVersion_++;
+	changedTiles_.clear();
+	changedTilesValid_ = false;
+	chunkWindow_ = nullptr;
+}
+
+void CollisionMap::BucketFootprints() {
+	chunkFootprints_.clear();
+	const int chunksX = chunkedMap_->getChunksX();
+	auto add = [&](const TileRect& footprint) {
+		for (int chunkY = footprint.minY / ChunkedGrid::chunkSize; chunkY <= footprint.maxY / ChunkedGrid::chunkSize; ++chunkY) {
+			for (int chunkX = footprint.minX / ChunkedGrid::chunkSize; chunkX <= footprint.maxX / ChunkedGrid::chunkSize; ++chunkX) {
+				chunkFootprints_[chunkY * chunksX + chunkX].push_back(footprint);
+			}
+		}
+	};
+
+	for (const TileRect& footprint : staticFootprints_) {
+		add(footprint);
+	}
+	for (const auto& footprint : footprints_) {
+		add(footprint.second);
+	}
+}
+
+bool CollisionMap::FindChunkedPath(int xStart, int yStart, int xEnd, int yEnd, int sizeClass, std::vector<Vector2>& path) {
+	const int mapWidth = chunkedMap_->getWidth();
+	const int mapHeight = chunkedMap_->getHeight();
+	const int chunkSize = ChunkedGrid::chunkSize;
+
+	// An end the agent does not fit on fails however wide the window
+	for (int y = yEnd; y < yEnd + sizeClass; ++y) {
+		for (int x = xEnd; x < xEnd + sizeClass; ++x) {
+			if (chunkedMap_->isBlocked(x, y))
+				return true;
+		}
+	}
+
+	// Ends further apart than a route window are routed over the entrances between chunks
+	const int routeDistance = ChunkPortals::windowChunks * chunkSize;
+	if (std::abs(xEnd - xStart) > routeDistance || std::abs(yEnd - yStart) > routeDistance) {
+		return FindChunkRoute(xStart, yStart, xEnd, yEnd, sizeClass, path);
+	}
+
+	// Search a window of whole chunks around both ends. A path may have to leave
+	// it, so an empty result widens the window until it is the whole map or too large.
+	bool searched = false;
+	for (int margin = chunkSize; ; margin *= 4) {
+		TileRect rect;
+		rect.minX = (std::max)(0, (std::min)(xStart, xEnd) - margin) / chunkSize * chunkSize;
+		rect.minY = (std::max)(0, (std::min)(yStart, yEnd) - margin) / chunkSize * chunkSize;
+		rect.maxX = (std::min)(mapWidth - 1, ((std::max)(xStart, xEnd) + sizeClass + margin) / chunkSize * chunkSize + chunkSize - 1);
+		rect.maxY = (std::min)(mapHeight - 1, ((std::max)(yStart, yEnd) + sizeClass + margin) / chunkSize * chunkSize + chunkSize - 1);
+
+		const TileRect& window = chunkWindowRect_;
+		if (!chunkWindow_ || rect.minX < window.minX || rect.minY < window.minY || rect.maxX > window.maxX || rect.maxY > window.maxY) {
+			// A window holds clearance, four jump distances and a search node per tile
+			const size_t tiles = static_cast<size_t>(rect.maxX - rect.minX + 1) * (rect.maxY - rect.minY + 1);
+			if (tiles * (1 + 4 * sizeof(int) + sizeof(SearchNode)) > chunkedMaxBytes_)
+				break;
+
+			OccupancyGrid occupancy;
+			chunkedMap_->copyRect(rect.minX, rect.minY, rect.maxX, rect.maxY, occupancy);
+			chunkWindow_ = std::make_shared<Pathfinder>(occupancy.getWidth(), occupancy.getHeight());
+			chunkWindow_->setOccupancy(occupancy);
+			chunkWindowRect_ = rect;
+		}
+		else if (searched) {
+			// The window already searched holds this margin too
+			continue;
+		}
+
+		searched = true;
+		chunkWindow_->setEntitySize(sizeClass);
+		std::vector<std::shared_ptr<AstarTile>> tilePath = chunkWindow_->newPath(xStart - window.minX, yStart - window.minY,
+			xEnd - window.minX, yEnd - window.minY, searchOptions_);
+		const bool wholeMap = window.minX == 0 && window.minY == 0 && window.maxX == mapWidth - 1 && window.maxY == mapHeight - 1;
+		if (!tilePath.empty() || wholeMap) {
+			// Window tiles are map tiles shifted by the window's corner
+			const float cellSize = smallestEntitySize_ / accuracy_;
+			const float originX = worldStartX_ + (window.minX + sizeClass * 0.5f) * cellSize;
+			const float originY = worldStartY_ + (window.minY + sizeClass * 0.5f) * cellSize;
+			for (const auto& tile : tilePath) {
+				path.emplace_back(tile->getX() * cellSize + originX, tile->getY() * cellSize + originY);
+			}
+			return true;
+		}
+	}
+
+	// No window within the budget found a way round
+	return FindChunkRoute(xStart, yStart, xEnd, yEnd, sizeClass, path);
+}
+
+bool CollisionMap::FindChunkRoute(int xStart, int yStart, int xEnd, int yEnd, int sizeClass, std::vector<Vector2>& path) {
+	std::vector<ChunkPortals::Leg> legs;
+	if (!chunkPortals_->findRoute(xStart, yStart, xEnd, yEnd, sizeClass, legs)) {
+		return true;
+	}
+
+	// Legs are searched a few at a time, in a window holding only their chunks and
+	// the tiles footprints reach past them, so the path bends freely except where
+	// two windows meet.
+	const int chunkSize = ChunkedGrid::chunkSize;
+	const int chunksX = chunkedMap_->getChunksX();
+	const float cellSize = smallestEntitySize_ / accuracy_;
+	const size_t first = path.size();
+	for (size_t from = 0; from < legs.size(); ) {
+		int minChunkX = legs[from].chunk % chunksX;
+		int minChunkY = legs[from].chunk / chunksX;
+		int maxChunkX = minChunkX;
+		int maxChunkY = minChunkY;
+		size_t to = from;
+		while (to + 1 < legs.size()) {
+			const int chunkX = legs[to + 1].chunk % chunksX;
+			const int chunkY = legs[to + 1].chunk / chunksX;
+			const int spanX = (std::max)(maxChunkX, chunkX) - (std::min)(minChunkX, chunkX) + 1;
+			const int spanY = (std::max)(maxChunkY, chunkY) - (std::min)(minChunkY, chunkY) + 1;
+			const size_t tiles = static_cast<size_t>(spanX) * spanY * chunkSize * chunkSize;
+			if (spanX > ChunkPortals::windowChunks || spanY > ChunkPortals::windowChunks || tiles * (1 + 4 * sizeof(int) + sizeof(SearchNode)) > chunkedMaxBytes_)
+				break;
+			minChunkX = (std::min)(minChunkX, chunkX);
+			minChunkY = (std::min)(minChunkY, chunkY);
+			maxChunkX = (std::max)(maxChunkX, chunkX);
+			maxChunkY = (std::max)(maxChunkY, chunkY);
+			++to;
+		}
+
+		const int minX = minChunkX * chunkSize;
+		const int minY = minChunkY * chunkSize;
+		const int maxX = (std::min)(chunkedMap_->getWidth() - 1, (maxChunkX + 1) * chunkSize + sizeClass - 2);
+		const int maxY = (std::min)(chunkedMap_->getHeight() - 1, (maxChunkY + 1) * chunkSize + sizeClass - 2);
+		OccupancyGrid occupancy(maxX - minX + 1, maxY - minY + 1);
+		occupancy.fillRect(0, 0, maxX - minX, maxY - minY);
+		for (size_t leg = from; leg <= to; ++leg) {
+			const int x = legs[leg].chunk % chunksX * chunkSize;
+			const int y = legs[leg].chunk / chunksX * chunkSize;
+			OccupancyGrid tiles;
+			chunkedMap_->copyRect(x, y, x + chunkSize + sizeClass - 2, y + chunkSize + sizeClass - 2, tiles);
+			occupancy.copyBlock(tiles, 0, 0, x - minX, y - minY, tiles.getWidth(), tiles.getHeight());
+		}
+		Pathfinder pathfinder(occupancy.getWidth(), occupancy.getHeight(), sizeClass);
+		pathfinder.setOccupancy(occupancy);
+
+		std::vector<std::shared_ptr<AstarTile>> tilePath = pathfinder.newPath(legs[from].xFrom - minX, legs[from].yFrom - minY,
+			legs[to].xTo - minX, legs[to].yTo - minY, searchOptions_);
+		if (tilePath.empty()) {
+			path.resize(first);
+			return true;
+		}
+		const float originX = worldStartX_ + (minX + sizeClass * 0.5f) * cellSize;
+		const float originY = worldStartY_ + (minY + sizeClass * 0.5f) * cellSize;
+		for (const auto& tile : tilePath) {
+			path.emplace_back(tile->getX() * cellSize + originX, tile->getY() * cellSize + originY);
+		}
+		from = to + 1;
+	}
+	return true;
+}
+
+OccupancyGrid CollisionMap::GenerateOccupancy(std::list<std::shared_ptr<Collider>>& colliders, std::unordered_map<const Collider*, TileRect>& footprints,
+	const OccupancyGrid* base) {
+
+	const int mapWidth = static_cast<int>(std::ceil(worldWidth_));
+	const int mapHeight = static_cast<int>(std::ceil(worldHeight_));
+
+	const float cellSize = smallestEntitySize_ / accuracy_;
+	if (cellSize <= 0.0f) {
+		throw std::runtime_error("Invalid CollisionMap cell size");
+	}
+
+	// Initialize empty map, one bit per tile, or start from the base layer
+	OccupancyGrid occupancy = base ? *base : OccupancyGrid(mapWidth, mapHeight);
+
+	// Mark tiles with collisions, one masked span per row
+	footprints.clear();
+	for (const auto& collider : colliders) {
+		TileRect footprint;
+		if (!FootprintOf(*collider, footprint)) continue;
+
+		footprints[collider.get()] = footprint;
+		occupancy.fillRect(footprint.minX, footprint.minY, footprint.maxX, footprint.maxY);
+	}
+
+	return occupancy;
+}
+
+void CollisionMap::UpdateFootprints(std::list<std::shared_ptr<Collider>>& colliders, std::vector<TileRect>& dirty) {
+	// Footprints that moved count twice, where they were and where they are now
+	std::unordered_map<const Collider*, TileRect> footprints;
+	for (const auto& collider : colliders) {
+		TileRect footprint;
+		if (!FootprintOf(*collider, footprint)) continue;
+
+		footprints[collider.get()] = footprint;
+		auto previous = footprints_.find(collider.get());
+		if (previous == footprints_.end()) {
+			dirty.push_back(footprint);
+			continue;
+		}
+		if (previous->second != footprint) {
+			dirty.push_back(previous->second);
+			dirty.push_back(footprint);
+		}
+		footprints_.erase(previous);
+	}
+	for (const auto& removed : footprints_) {
+		dirty.push_back(removed.second);
+	}
+	footprints_ = std::move(footprints);
+}
+
+void CollisionMap::UpdateOccupancy(std::list<std::shared_ptr<Collider>>& colliders, std::vector<int>& changedTiles) {
+	std::vector<TileRect> dirty;
+	UpdateFootprints(colliders, dirty);
+
+	// Clear each dirty rectangle, down to the static layer if there is one, and draw back every footprint that overlaps it
+	std::vector<char> before;
+	for (const TileRect& rect : dirty) {
+		before.clear();
+		for (int y = rect.minY; y <= rect.maxY; ++y) {
+			for (int x = rect.minX; x <= rect.maxX; ++x) {
+				before.push_back(occupancy_.isBlocked(x, y));
+			}
+		}
+
+		if (staticLayer_) {
+			occupancy_.copyRect(staticLayer_->occupancy, rect.minX, rect.minY, rect.maxX, rect.maxY);
+		}
+		else {
+			occupancy_.fillRect(rect.minX, rect.minY, rect.maxX, rect.maxY, false);
+		}
+		for (const auto& other : footprints_) {
+			const TileRect& footprint = other.second;
+			occupancy_.fillRect((std::max)(rect.minX, footprint.minX), (std::max)(rect.minY, footprint.minY),
+				(std::min)(rect.maxX, footprint.maxX), (std::min)(rect.maxY, footprint.maxY));
+		}
+
+		size_t i = 0;
+		for (int y = rect.minY; y <= rect.maxY; ++y) {
+			for (int x = rect.minX; x <= rect.maxX; ++x) {
+				if (occupancy_.isBlocked(x, y) != (before[i++] != 0)) {
+					changedTiles.push_back(y * occupancy_.getWidth() + x);
+				}
+			}
+		}
+	}
+
+	// Overlapping rectangles report a tile once each
+	std::sort(changedTiles.begin(), changedTiles.end());
+	changedTiles.erase(std::unique(changedTiles.begin(), changedTiles.end()), changedTiles.end());
+}
+
+bool CollisionMap::FootprintOf(const Collider& collider, TileRect& footprint) const {
+	auto gameObject = collider.GetGameObject();
+	if (!gameObject) return false;
+	auto& transform = gameObject->transform;
+	auto box = gameObject->GetComponent<BoxCollider>();
+	auto circle = gameObject->GetComponent<CircleCollider>();
+
+	if (auto agentComp = gameObject->GetComponent<AIAgent>()) {
+		return false; // skip AI agents
+	}
+
+	float startX = transform.GetWorldPosition().getX();
+	float startY = transform.GetWorldPosition().getY();
+	float endX = startX;
+	float endY = startY;
+	if (box) {
+		float halfWidth = box->GetWidth() * 0.5f;
+		float halfHeight = box->GetHeight() * 0.5f;
+		startX -= halfWidth;
+		startY -= halfHeight;
+		endX += halfWidth;
+		endY += halfHeight;
+	}
+	else if (circle) {
+		float radius = circle->GetRadius();
+		startX -= radius;
+		startY -= radius;
+		endX += radius;
+		endY += radius;
+	}
+	else {
+		return false; // skip invalid collider
+	}
+
+	const int mapWidth = static_cast<int>(std::ceil(worldWidth_));
+	const int mapHeight = static_cast<int>(std::ceil(worldHeight_));
+	const float cellSize = smallestEntitySize_ / accuracy_;
+
+	// Convert world coordinates to tile indices, clamped to map bounds
+	footprint.minX = ClampInt(static_cast<int>(std::floor((startX - worldStartX_) / cellSize)), 0, mapWidth - 1);
+	footprint.minY = ClampInt(static_cast<int>(std::floor((startY - worldStartY_) / cellSize)), 0, mapHeight - 1);
+	footprint.maxX = ClampInt(static_cast<int>(std::floor((endX - worldStartX_) / cellSize)), 0, mapWidth - 1);
+	footprint.maxY = ClampInt(static_cast<int>(std::floor((endY - worldStartY_) / cellSize)), 0, mapHeight - 1);
+	return true;
+}
+
+std::vector<NavObstacle> CollisionMap::GatherObstacles(std::list<std::shared_ptr<Collider>>& colliders) const {
+	std::vector<NavObstacle> obstacles;
+	for (const auto& collider : colliders) {
+		auto gameObject = collider->GetGameObject();
+		if (!gameObject || gameObject->GetComponent<AIAgent>()) continue;
+
+		NavObstacle obstacle;
+		obstacle.x = gameObject->transform.GetWorldPosition().getX();
+		obstacle.y = gameObject->transform.GetWorldPosition().getY();
+		if (auto box = gameObject->GetComponent<BoxCollider>()) {
+			obstacle.halfWidth = box->GetWidth() * 0.5f;
+			obstacle.halfHeight = box->GetHeight() * 0.5f;
+		}
+		else if (auto circle = gameObject->GetComponent<CircleCollider>()) {
+			obstacle.radius = circle->GetRadius();
+		}
+		else {
+			continue; // skip invalid collider
+		}
+		obstacles.push_back(obstacle);
+	}
+	return obstacles;
+}
+
+uint64_t CollisionMap::SceneHash(std::list<std::shared_ptr<Collider>>& colliders, std::unordered_map<const Collider*, TileRect>& footprints) const {
+	// Summed, so the order colliders are listed in does not matter; static ones hash apart from dynamic ones
+	const uint64_t staticSeed = NavAsset::hash("static", 6);
+	uint64_t hash = 0;
+	for (const auto& collider : staticColliders_) {
+		TileRect footprint;
+		if (FootprintOf(*collider, footprint)) {
+			hash += NavAsset::hash(&footprint, sizeof(footprint), staticSeed);
+		}
+	}
+
+	footprints.clear();
+	for (const auto& collider : colliders) {
+		TileRect footprint;
+		if (!FootprintOf(*collider, footprint)) continue;
+
+		footprints[collider.get()] = footprint;
+		hash += NavAsset::hash(&footprint, sizeof(footprint));
+	}
+	return hash;
+}
+
+bool CollisionMap::WorldToTile(const Vector2& position, int& x, int& y, int sizeClass) const {
+	const float cellSize = smallestEntitySize_ / accuracy_;
+	const int mapWidth = static_cast<int>(std::ceil(worldWidth_));
+	const int mapHeight = static_cast<int>(std::ceil(worldHeight_));
+	if (cellSize <= 0.0f || mapWidth <= 0 || mapHeight <= 0)
+		return false;
+
+	const float footprintOffset = (sizeClass - 1) * 0.5f;
+	x = (std::max)(0, (std::min)(static_cast<int>(std::floor((position.getX() - worldStartX_) / cellSize - footprintOffset)), mapWidth - 1));
+	y = (std::max)(0, (std::min)(static_cast<int>(std::floor((position.getY() - worldStartY_) / cellSize - footprintOffset)), mapHeight - 1));
+	return true;
+}
+
+int CollisionMap::SizeClassOf(float agentSize) const {
+	const float cellSize = smallestEntitySize_ / accuracy_;
+	if (agentSize <= 0.0f || cellSize <= 0.0f)
+		return 1;
+
+	// Small tolerance so an agent exactly one cell wide stays in size class 1
+	int tiles = static_cast<int>(std::ceil(agentSize / cellSize - 0.001f));
+	return (std::max)(1, (std::min)(tiles, Pathfinder::maxEntitySize));
+}
+
+void CollisionMap::FindMapData(std::list<std::shared_ptr<Collider>>& colliders) {
+
+	// Static colliders were measured once, only the dynamic ones are walked here
+	MapExtent extent = staticExtent_;
+	MeasureColliders(colliders, extent);
+
+	smallestEntitySize_ = extent.smallestEntitySize;
+	if (!extent.foundAny) {
+		return;
+	}
+
+	worldStartX_ = extent.minX;
+	worldStartY_ = extent.minY;
+	worldEndX_ = extent.maxX;
+	worldEndY_ = extent.maxY;
+
+	float deltaX = std::abs(worldEndX_ - worldStartX_);
+	float deltaY = std::abs(worldEndY_ - worldStartY_);
+
+	if (smallestEntitySize_ < 1.0f) smallestEntitySize_ = 1.0f;
+
+	worldWidth_ = deltaX / (smallestEntitySize_ / accuracy_);
+	worldHeight_ = deltaY / (smallestEntitySize_ / accuracy_);
+}
+
+void CollisionMap::MeasureColliders(std::list<std::shared_ptr<Collider>>& colliders, MapExtent& extent) const {
+
+	// For each collider, determine the smallest entity size and world size
+	for (const auto& collider : colliders) {
+		auto gameObject = collider->GetGameObject();
+		if (!gameObject) continue;
+
+		auto& transform = gameObject->transform;
+
+		auto box = gameObject->GetComponent<BoxCollider>();
+		auto circle = gameObject->GetComponent<CircleCollider>();
+
+		float startX = transform.GetWorldPosition().getX();
+		float startY = transform.GetWorldPosition().getY();
+		float endX = startX;
+		float endY = startY;
+
+		float entitySize;
+
+		if (box) {
+			entitySize = (std::min)(box->GetWidth(), box->GetHeight());
+			float halfWidth = box->GetWidth() * 0.5f;
+			float halfHeight = box->GetHeight() * 0.5f;
+			startX -= halfWidth;
+			startY -= halfHeight;
+			endX += halfWidth;
+			endY += halfHeight;
+		}
+		else if (circle) {
+			entitySize = circle->GetRadius() * 2.0f;
+			float radius = circle->GetRadius();
+			startX -= radius;
+			startY -= radius;
+			endX += radius;
+			endY += radius;
+		}
+		else {
+			continue; // skip invalid collider
+		}
+
+		extent.foundAny = true;
+
+		extent.smallestEntitySize = (std::min)(extent.smallestEntitySize, entitySize);
+
+		extent.minX = (std::min)(extent.minX, startX);
+		extent.minY = (std::min)(extent.minY, startY);
+		extent.maxX = (std::max)(extent.maxX, endX);
+		extent.maxY = (std::max)(extent.maxY, endY);
+	}
 }
\ No newline at end of file
@@ -1,44 +1,357 @@
-#pragma once
-
-#include "Pathfinder.h"
-#include "Vector2.h"
-#include "Collider.h"
-#include "AstarTile.h"
-#include <memory>
-#include <list>
-#include <vector>
-#include <algorithm>
-
-class CollisionMap {
-public:
-	CollisionMap();
-	~CollisionMap() = default;
-
-	std::vector<std::shared_ptr<Vector2>> GetPath(const std::shared_ptr<Vector2>& start, const std::shared_ptr<Vector2>& end);
-	void RefreshMap(std::list<std::shared_ptr<Collider>>& colliders);
-
-private:
-	std::shared_ptr<Pathfinder> pathfinder_;
-	
-	float accuracy_ = 1.0f;
-	float smallestEntitySize_ = 1.0f;
-
-	float worldStartX_ = 0.0f;
-	float worldStartY_ = 0.0f;
-	float worldEndX_ = 100.0f;
-	float worldEndY_ = 100.0f;
-
-	int worldWidth_ = 100;
-	int worldHeight_ = 100;
-
-	std::vector<std::vector<std::shared_ptr<AstarTile>>> GenerateTileMap(std::list<std::shared_ptr<Collider>>& colliders);
-	std::vector<std::vector<std::shared_ptr<AstarTile>>> tileMap_;
-
-	inline int ClampInt(int v, int lo, int hi) {
-		return (v < lo) ? lo : (v > hi) ? hi : v;
-	}
-
-	void FindMapData(std::list<std::shared_ptr<Collider>>& colliders); // find properties of agent size and world size, based on GameObject distributions
-
-
-};
+#pragma once
+
+#include "Pathfinder.h"
+#include "HierarchicalMap.h"
+#include "PathCache.h"
+#include "FlowField.h"
+#include "DStarLite.h"
+#include "OccupancyGrid.h"
+#include "PathRequestService.h"
+#include "LandmarkTable.h"
+#include "ComponentLabels.h"
+#include "NavMesh.h"
+#include "VisibilityGraph.h"
+#include "ChunkedGrid.h"
+#include "ChunkPortals.h"
+#include "Vector2.h"
+#include "Collider.h"
+#include "AstarTile.h"
+#include <memory>
+#include <list>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <unordered_map>
+#include <future>
+#include <atomic>
+#include <limits>
+#include <string>
+
+/// @brief What GetPath searches.
+enum class NavigationMode {
+	Grid,    ///< A* over the tile map
+	NavMesh, ///< A* over convex polygons built from the colliders, for open maps with few obstacles
+	VisibilityGraph, ///< A* over obstacle corners that see each other, exact shortest paths for a few box walls
+};
+
+class CollisionMap {
+public:
+	CollisionMap();
+	~CollisionMap();
+
+	/// @brief Find a path between two world positions.
+	/// @param agentSize Width of the agent in world units; 0 plans for the smallest size class.
+	std::vector<std::shared_ptr<Vector2>> GetPath(const std::shared_ptr<Vector2>& start, const std::shared_ptr<Vector2>& end, float agentSize = 0.0f);
+	/// @brief Find a path into a caller-owned buffer, which keeps its capacity between calls. Waypoints are
+	/// stored by value and the path is not drawn for debugging, so a query answered from the path cache allocates
+	/// nothing once the buffer has grown; a query that searches still allocates the tile path it builds.
+	/// @param path Cleared, then filled with the world path.
+	/// @return False when there is no path.
+	bool GetPath(const Vector2& start, const Vector2& end, std::vector<Vector2>& path, float agentSize = 0.0f);
+	/// @brief Plan with an agent's own incremental planner, which repairs its previous search
+	/// when the goal moves or tiles change instead of starting over.
+	/// @param planner Created on first use, keep it with the agent between calls.
+	std::vector<std::shared_ptr<Vector2>> GetPath(const Vector2& start, const Vector2& end, std::shared_ptr<DStarLite>& planner, float agentSize = 0.0f);
+	/// @brief Plan with an agent's own incremental planner into a caller-owned buffer, which keeps its capacity between calls.
+	/// @param path Cleared, then filled with the world path.
+	/// @return False when there is no path.
+	bool GetPath(const Vector2& start, const Vector2& end, std::shared_ptr<DStarLite>& planner, std::vector<Vector2>& path, float agentSize = 0.0f);
+	void RefreshMap(std::list<std::shared_ptr<Collider>>& colliders);
+
+	/// @brief Queue a path query on the worker threads instead of searching on the caller.
+	/// Queries between disconnected regions, and those whose path is cached, are answered without a search.
+	/// @param callback Runs inside DeliverPathResults with the world path, empty when the end cannot be reached.
+	/// @return Handle for CancelPathRequest, 0 when no map has been built yet.
+	unsigned RequestPath(const Vector2& start, const Vector2& end, float agentSize, std::function<void(std::vector<std::shared_ptr<Vector2>>)> callback);
+	/// @brief Queue a path query whose result is handed over by value, without a shared_ptr per waypoint.
+	/// @param callback Runs inside DeliverPathResults with the world path, empty when the end cannot be reached. The
+	/// path lives in a buffer reused by every delivery, so copy out what is needed before returning.
+	unsigned RequestPathInto(const Vector2& start, const Vector2& end, float agentSize, std::function<void(const std::vector<Vector2>&)> callback);
+	void CancelPathRequest(unsigned request);
+	/// @brief Whether the callback of a request is still to run. False once it has run, or the request was cancelled.
+	bool IsPathRequestPending(unsigned request) const;
+	/// @brief Hand finished requests to their callbacks, at most maxResults per call. Call once per frame.
+	/// @return Number of callbacks that ran.
+	size_t DeliverPathResults(size_t maxResults);
+
+	/// @brief Get the flow field towards a goal, built on first use and cached per goal tile and size class.
+	/// @param agentSize Width of the agents in world units; 0 builds the field for the smallest size class.
+	std::shared_ptr<const FlowField> GetFlowField(const Vector2& goal, float agentSize = 0.0f);
+	/// @brief Sample the flow field towards a goal at a world position.
+	/// @param direction Receives the normalized direction to the centre of the agent's next footprint.
+	/// @param agentSize Width of the agent, which is only led through gaps it fits.
+	/// @return False at the goal tile or where the goal cannot be reached.
+	bool GetFlowDirection(const Vector2& position, const Vector2& goal, Vector2& direction, float agentSize = 0.0f);
+
+	/// @brief Version of the tile map, bumped by RefreshMap whenever the map changes.
+	unsigned GetMapVersion() const { return mapVersion_; }
+	/// @brief Tiles (y * width + x) whose occupancy differs from the previous map version, for caches and
+	/// planners that repair themselves instead of starting over. Only complete when ChangedTilesKnown().
+	const std::vector<int>& GetChangedTiles() const { return changedTiles_; }
+	/// @brief False after a change of the map's size or position, when every tile may differ.
+	bool ChangedTilesKnown() const { return changedTilesValid_; }
+
+	/// @brief Hit, miss and eviction counters of the path cache.
+	const PathCacheStats& GetPathCacheStats() const { return pathCache_.getStats(); }
+	/// @brief Set the maximum number of cached paths (0 disables caching).
+	void SetPathCacheCapacity(size_t capacity) { pathCache_.setCapacity(capacity); }
+
+	/// @brief Choose the search used by GetPath and RequestPath, e.g. bidirectional A* to compare against the default,
+	/// or a weight above 1 for cheap, bounded-suboptimal paths for crowds. Anything but an unweighted
+	/// SearchMode::Auto search bypasses the cluster hierarchy.
+	/// The default trades optimality for speed on large maps: queries between clusters that are not neighbours
+	/// follow the hierarchy's routes, typically about 1% and at worst about a fifth longer than the shortest path.
+	/// Queries whose ends share or neighbour a cluster, where the detour would be the largest, search the tiles.
+	void SetSearchOptions(const SearchOptions& options);
+	const SearchOptions& GetSearchOptions() const { return searchOptions_; }
+
+	/// @brief Precompute ALT landmark tables for size class 1 on a background thread after every map change.
+	/// A* then bounds distances by the triangle inequality over the landmarks, which expands far fewer tiles
+	/// on maze-like maps. Until the table for the current map is ready, searches use the octile heuristic alone.
+	/// A map change cancels the build in flight without waiting for it, and one new build starts once it has stopped.
+	/// Without a static layer every edit changes the map the table is for; when colliders move every frame, give the
+	/// level geometry to SetStaticColliders, whose layer the table is then built on and kept for.
+	/// @param maxLandmarks Landmarks per table, 0 (the default) turns them off and frees the table.
+	/// @param maxBytes Memory cap per table; large maps get fewer landmarks.
+	void SetLandmarks(int maxLandmarks, size_t maxBytes = 16u << 20);
+
+	/// @brief Choose what a query does when its end lies in a region the start cannot reach, which the
+	/// region labels tell without a search. By default it fails at once with an empty path.
+	/// @param redirect Plan to the reachable tile closest to the end instead.
+	/// @param maxRadius How far from the end, in tiles, to look for that tile.
+	void SetRedirectUnreachable(bool redirect, int maxRadius = 32);
+
+	/// @brief Choose what GetPath searches. In NavigationMode::NavMesh a query crosses a few hundred polygons
+	/// instead of every tile, and the path bends only at obstacle corners. NavigationMode::VisibilityGraph
+	/// searches just the obstacle corners, whose mutual visibility is cached until the colliders move; its
+	/// queries cost the same however large the world is. The tile map is still kept for the incremental
+	/// planner, path requests and flow fields.
+	void SetNavigationMode(NavigationMode mode) { navigationMode_ = mode; }
+	NavigationMode GetNavigationMode() const { return navigationMode_; }
+
+	/// @brief Run full rebuilds, at level load or when the world changes size, on a worker thread instead of
+	/// stalling the frame that called RefreshMap. The frame only reads where the colliders are; the tiles are drawn
+	/// and searched on the worker. Queries keep using the previous map until the new one is swapped in whole by
+	/// the next GetPath, RequestPath, DeliverPathResults or RefreshMap after it is done. A refresh while a rebuild
+	/// runs is remembered, and the swap is followed by a catch-up refresh with the colliders it was given. Loading
+	/// navigation or changing the map form cancels a rebuild without waiting for it to stop.
+	void SetBackgroundRebuild(bool background) { backgroundRebuild_ = background; }
+	/// @brief True while a background rebuild has not been swapped in yet.
+	bool IsRebuilding() const { return mapBuild_.valid(); }
+
+	/// @brief Bake colliders that never move, such as level geometry, into a static layer of their own. RefreshMap
+	/// then takes only the dynamic colliders (props, doors, agents) and redraws changed tiles down to the static
+	/// layer, never the static colliders themselves. Region labels and landmarks are computed on the static layer
+	/// and kept while dynamic colliders move, so a query blocked only by dynamic colliders searches before it fails.
+	/// The layer is baked by the next RefreshMap and again whenever the map changes size; an empty list removes it.
+	void SetStaticColliders(std::list<std::shared_ptr<Collider>>& colliders);
+
+	/// @brief Keep the tile map in chunks of ChunkedGrid::chunkSize tiles instead of one grid over every collider, for
+	/// worlds too large to hold. A chunk is drawn from the colliders when a search first reads it; chunks all free or
+	/// all blocked take a byte, the rest are dropped least recently used first beyond maxBytes. GetPath searches a
+	/// window of chunks around nearby ends, widened while no path is found as long as its search data stays within
+	/// maxBytes. Ends further apart, or past that, are routed over the entrances between chunks first and then
+	/// searched a few chunks of the route at a time; the entrances kept take up to maxBytes more.
+	/// Path requests, flow fields, the incremental planner, the hierarchy and landmarks need the whole map and
+	/// find nothing while the map is chunked.
+	/// @param maxBytes Memory for chunk tiles; 0 (the default) keeps one grid. The map is rebuilt by the next RefreshMap.
+	void SetChunkedMap(size_t maxBytes);
+
+	/// @brief Build the map for the colliders and write it to a file for LoadNavigation, as a step of the level build
+	/// rather than at startup. The file holds the tile map, its static layer, the cluster hierarchy, region labels and,
+	/// when SetLandmarks asks for them, the landmark table, so loading computes none of them again.
+	/// @return False for a chunked map or when the file could not be written.
+	bool BakeNavigation(std::list<std::shared_ptr<Collider>>& colliders, const std::string& path);
+	/// @brief Take the map from a file written by BakeNavigation instead of building it. The file is memory mapped and
+	/// copied straight into the map's structures. It is only used when its format version and checksum hold and it was
+	/// baked for the same colliders (static and dynamic) at the same layout; anything else falls back to RefreshMap.
+	/// @return True when the map came from the file.
+	bool LoadNavigation(std::list<std::shared_ptr<Collider>>& colliders, const std::string& path);
+
+	/// @brief Send every path found by the shared_ptr GetPath to the render system's debug overlay (on by default).
+	/// The overlay takes shared_ptr waypoints, so the buffer overloads never draw.
+	void SetDrawDebugPaths(bool draw) { drawDebugPaths_ = draw; }
+
+private:
+	std::shared_ptr<Pathfinder> pathfinder_;
+	std::shared_ptr<HierarchicalMap> hierarchy_; // only built for maps of at least hierarchyMinTiles_
+	
+	int clusterSize_ = 16;
+	int hierarchyMinTiles_ = 128 * 128; // the hierarchy serves size class 1, larger agents search the flat map
+
+	SearchOptions searchOptions_;
+	PathCache pathCache_;
+	unsigned searchGeneration_ = 0; // bumped whenever cached paths stop matching what a search would return
+	std::unique_ptr<PathRequestService> pathRequests_; // worker threads start with the first request
+	std::vector<Vector2> deliveredPath_; // world path of the result being delivered, reused between results
+
+	int landmarkCount_ = 0;
+	size_t landmarkMaxBytes_ = 16u << 20;
+	std::future<std::shared_ptr<const LandmarkTable>> landmarkBuild_;
+	std::shared_ptr<std::atomic<bool>> landmarkCancel_; // set to abandon the build in flight
+	bool landmarkStale_ = false; // the build in flight was cancelled, its table is dropped when it stops
+
+	std::vector<std::shared_ptr<const ComponentLabels>> components_; // per size class, labelled on first use
+	bool redirectUnreachable_ = false;
+	int redirectRadius_ = 32;
+	bool drawDebugPaths_ = true;
+
+	NavigationMode navigationMode_ = NavigationMode::Grid;
+	std::vector<NavObstacle> obstacles_; // colliders of the current map, agents and the static layer left out
+	std::vector<std::shared_ptr<const NavMesh>> navMeshes_; // per size class, built on first use
+	std::vector<std::shared_ptr<const VisibilityGraph>> visibilityGraphs_; // per size class, built on first use
+	unsigned mapVersion_ = 0;
+	std::vector<int> changedTiles_; // tiles that differ from the previous version
+	bool changedTilesValid_ = false; // false when the layout changed and every tile may differ
+
+	std::list<std::shared_ptr<FlowField>> flowFields_; // most recently used first
+	size_t flowFieldCapacity_ = 4;
+
+	float accuracy_ = 1.0f;
+	float smallestEntitySize_ = 1.0f;
+
+	float worldStartX_ = 0.0f;
+	float worldStartY_ = 0.0f;
+	float worldEndX_ = 100.0f;
+	float worldEndY_ = 100.0f;
+
+	int worldWidth_ = 100;
+	int worldHeight_ = 100;
+
+	// Inclusive tile rectangle a collider covers
+	struct TileRect {
+		int minX = 0;
+		int minY = 0;
+		int maxX = -1;
+		int maxY = -1;
+
+		bool operator!=(const TileRect& other) const {
+			return minX != other.minX || minY != other.minY || maxX != other.maxX || maxY != other.maxY;
+		}
+	};
+
+	/// @param base Layer to draw the colliders over, an empty map when null.
+	OccupancyGrid GenerateOccupancy(std::list<std::shared_ptr<Collider>>& colliders, std::unordered_map<const Collider*, TileRect>& footprints,
+		const OccupancyGrid* base = nullptr);
+	/// @brief Redraw only the footprints that moved, appeared or disappeared since the last refresh.
+	/// @param changedTiles Receives every tile whose occupancy flipped, sorted.
+	void UpdateOccupancy(std::list<std::shared_ptr<Collider>>& colliders, std::vector<int>& changedTiles);
+	bool FootprintOf(const Collider& collider, TileRect& footprint) const; // false for agents and colliders without a shape
+	/// @brief Take the current footprints of the colliders into footprints_.
+	/// @param dirty Receives where footprints moved from and to, appeared or disappeared.
+	void UpdateFootprints(std::list<std::shared_ptr<Collider>>& colliders, std::vector<TileRect>& dirty);
+	std::vector<NavObstacle> GatherObstacles(std::list<std::shared_ptr<Collider>>& colliders) const;
+	OccupancyGrid occupancy_; // one bit per tile, set where a collider covers it
+	std::unordered_map<const Collider*, TileRect> footprints_; // last drawn footprint of every collider
+
+	// Bounds and smallest size of a set of colliders in world units
+	struct MapExtent {
+		float minX = 999999.0f;
+		float minY = 999999.0f;
+		float maxX = std::numeric_limits<float>::lowest();
+		float maxY = std::numeric_limits<float>::lowest();
+		float smallestEntitySize = 999999.0f;
+		bool foundAny = false;
+	};
+
+	// Colliders given to SetStaticColliders, drawn for one layout
+	struct StaticLayer {
+		OccupancyGrid occupancy;
+		std::shared_ptr<const NavGrid> grid; // region labels and landmarks are computed on this
+		std::vector<NavObstacle> obstacles;
+	};
+
+	std::list<std::shared_ptr<Collider>> staticColliders_;
+	MapExtent staticExtent_; // measured once, so refreshes only walk the dynamic colliders
+	std::shared_ptr<const StaticLayer> staticLayer_; // for the current layout, null without static colliders
+	bool staticLayerStale_ = false; // the static colliders changed since the layer was baked
+
+	std::shared_ptr<StaticLayer> BakeStaticLayer(); // draws the layer for the current layout, leaves its grid to the caller
+	std::shared_ptr<const NavGrid> BaseGrid() const; // grid region labels and landmarks describe
+	std::vector<NavObstacle> NavObstacles() const; // static and dynamic obstacles together
+	/// @brief Fingerprint of every footprint for the current layout, whatever order the colliders come in.
+	/// @param footprints Receives the footprints of the dynamic colliders.
+	uint64_t SceneHash(std::list<std::shared_ptr<Collider>>& colliders, std::unordered_map<const Collider*, TileRect>& footprints) const;
+
+	// Where the tile map lies in the world; FindMapData sets it from the colliders
+	struct MapLayout {
+		float worldStartX;
+		float worldStartY;
+		float worldEndX;
+		float worldEndY;
+		int worldWidth;
+		int worldHeight;
+		float smallestEntitySize;
+	};
+
+	// Everything a full rebuild replaces, built off the main thread and swapped in at once. Colliders are
+	// read on the calling thread; the worker draws their footprints.
+	struct MapBuild {
+		MapLayout layout;
+		OccupancyGrid occupancy;
+		std::unordered_map<const Collider*, TileRect> footprints;
+		std::vector<NavObstacle> obstacles;
+		std::shared_ptr<Pathfinder> pathfinder;
+		std::shared_ptr<HierarchicalMap> hierarchy;
+		std::vector<std::shared_ptr<const ComponentLabels>> components;
+		std::shared_ptr<StaticLayer> staticLayer;
+		std::vector<TileRect> staticFootprints; // drawn into staticLayer by the worker
+	};
+
+	size_t chunkedMaxBytes_ = 0; // 0 while the map is one grid
+	std::unique_ptr<ChunkedGrid> chunkedMap_;
+	std::unique_ptr<ChunkPortals> chunkPortals_; // of chunkedMap_, replaced with it
+	std::vector<TileRect> staticFootprints_; // of the static colliders, drawn into chunks with the dynamic ones
+	std::unordered_map<int, std::vector<TileRect>> chunkFootprints_; // footprints overlapping each chunk
+	std::shared_ptr<Pathfinder> chunkWindow_; // last window searched, reused while a query fits in it
+	TileRect chunkWindowRect_;
+
+	void RefreshChunks(std::list<std::shared_ptr<Collider>>& colliders, bool sameLayout);
+	void BucketFootprints(); // sort every footprint into the chunks it overlaps
+	bool FindChunkedPath(int xStart, int yStart, int xEnd, int yEnd, int sizeClass, std::vector<Vector2>& path);
+	bool FindChunkRoute(int xStart, int yStart, int xEnd, int yEnd, int sizeClass, std::vector<Vector2>& path);
+
+	bool backgroundRebuild_ = false;
+	std::future<std::shared_ptr<MapBuild>> mapBuild_;
+	std::shared_ptr<std::atomic<bool>> mapBuildCancel_; // set to abandon the build in flight
+	std::vector<std::future<std::shared_ptr<MapBuild>>> retiredMapBuilds_; // cancelled, kept until they stop
+	std::list<std::shared_ptr<Collider>> pendingColliders_; // of refreshes made while a rebuild ran
+	bool refreshPending_ = false;
+
+	MapLayout GetLayout() const;
+	void SetLayout(const MapLayout& layout);
+	void StartRebuild(std::list<std::shared_ptr<Collider>>& colliders, const MapLayout& previous);
+	void InstallMap(); // swap in a finished background rebuild
+	void CancelRebuild(); // abandon the build in flight without waiting for it
+
+	void PublishMap(); // hand the current grid and landmarks to the path request workers
+	void BuildLandmarks();
+	void CancelLandmarks(); // abandon the build in flight without waiting for it
+	void InstallLandmarks(); // adopt a finished background build, if it is for the current map
+
+	const ComponentLabels& ComponentsFor(int sizeClass);
+	const NavMesh& NavMeshFor(int sizeClass);
+	const VisibilityGraph& VisibilityGraphFor(int sizeClass);
+	void GetNavBounds(float& minX, float& minY, float& maxX, float& maxY) const; // extent of the tile map in world units
+	/// @brief False when the end cannot be reached from the start; may move the end to the nearest reachable tile.
+	bool ResolveGoal(int xStart, int yStart, int& xEnd, int& yEnd, int sizeClass);
+	bool NearbyClusters(int xStart, int yStart, int xEnd, int yEnd) const; // ends in the same or neighbouring hierarchy clusters
+
+	bool FindPath(const Vector2& start, const Vector2& end, std::vector<Vector2>& path, float agentSize); // GetPath without drawing
+	void DrawDebugPath(const std::vector<std::shared_ptr<Vector2>>& path);
+
+	void ToWorldPath(const std::vector<std::shared_ptr<AstarTile>>& tilePath, int sizeClass, std::vector<Vector2>& path) const;
+	std::vector<std::shared_ptr<Vector2>> ToWorldPath(const std::vector<std::shared_ptr<AstarTile>>& tilePath, int sizeClass) const;
+
+	bool WorldToTile(const Vector2& position, int& x, int& y, int sizeClass = 1) const;
+	int SizeClassOf(float agentSize) const; // agent width in tiles, rounded up
+
+	static int ClampInt(int v, int lo, int hi) {
+		return (v < lo) ? lo : (v > hi) ? hi : v;
+	}
+
+	void FindMapData(std::list<std::shared_ptr<Collider>>& colliders); // find properties of agent size and world size, based on GameObject distributions
+	void MeasureColliders(std::list<std::shared_ptr<Collider>>& colliders, MapExtent& extent) const; // grow extent to cover the colliders
+
+
+};
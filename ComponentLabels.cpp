@@ -0,0 +1,264 @@
+#include "../Headers/ComponentLabels.h"
+#include <algorithm>
+#include <climits>
+
+namespace {
+    // Tiles not labelled yet while a flood runs
+    const int unlabelled = -2;
+
+    int findRoot(std::vector<int>& parents, int label)
+    {
+        while (parents[label] != label) {
+            parents[label] = parents[parents[label]];
+            label = parents[label];
+        }
+        return label;
+    }
+}
+
+ComponentLabels::ComponentLabels(const NavGrid& grid, int entitySize)
+    : width(grid.getWidth()), height(grid.getHeight()), entitySize(entitySize), gridSerial(grid.getSerial())
+{
+    labelAll(grid);
+}
+
+ComponentLabels::ComponentLabels(const NavGrid& grid, int entitySize, int componentCount, const int* labels)
+    : width(grid.getWidth()), height(grid.getHeight()), entitySize(entitySize), gridSerial(grid.getSerial()),
+    componentCount(componentCount), labels(labels, labels + static_cast<size_t>(grid.getWidth()) * grid.getHeight())
+{
+}
+
+ComponentLabels::ComponentLabels(const NavGrid& grid, const ComponentLabels& previous, const std::vector<int>& changedTiles)
+    : width(grid.getWidth()), height(grid.getHeight()), entitySize(previous.entitySize), gridSerial(grid.getSerial())
+{
+    if (previous.width != width || previous.height != height) {
+        labelAll(grid);
+        return;
+    }
+
+    labels = previous.labels;
+    int next = previous.componentCount;
+
+    // An occupancy change reaches every footprint that covers the tile
+    std::vector<int> blocked;
+    std::vector<int> opened;
+    for (int t : changedTiles) {
+        const int x0 = t % width;
+        const int y0 = t / width;
+        for (int y = (std::max)(0, y0 - entitySize + 1); y <= y0; ++y) {
+            for (int x = (std::max)(0, x0 - entitySize + 1); x <= x0; ++x) {
+                const int i = y * width + x;
+                const bool walkable = grid.clearanceAt(i) >= entitySize;
+                if (walkable != (labels[i] >= 0))
+                    (walkable ? opened : blocked).push_back(i);
+            }
+        }
+    }
+    std::sort(blocked.begin(), blocked.end());
+    blocked.erase(std::unique(blocked.begin(), blocked.end()), blocked.end());
+    std::sort(opened.begin(), opened.end());
+    opened.erase(std::unique(opened.begin(), opened.end()), opened.end());
+
+    // New obstacles, grouped where they touch, only split their region when
+    // the free tiles around a group are no longer joined around it
+    std::vector<char> dirty(next, 0);
+    bool anyDirty = false;
+    std::vector<char> grouped(blocked.size(), 0);
+    std::vector<int> group;
+    for (size_t first = 0; first < blocked.size(); ++first) {
+        if (grouped[first])
+            continue;
+
+        grouped[first] = 1;
+        group.assign(1, static_cast<int>(first));
+        int minX = blocked[first] % width;
+        int maxX = minX;
+        int minY = blocked[first] / width;
+        int maxY = minY;
+        for (size_t g = 0; g < group.size(); ++g) {
+            const int x = blocked[group[g]] % width;
+            const int y = blocked[group[g]] / width;
+            minX = (std::min)(minX, x);
+            maxX = (std::max)(maxX, x);
+            minY = (std::min)(minY, y);
+            maxY = (std::max)(maxY, y);
+            for (int ny = y - 1; ny <= y + 1; ++ny) {
+                for (int nx = x - 1; nx <= x + 1; ++nx) {
+                    if (nx < 0 || nx >= width || ny < 0 || ny >= height)
+                        continue;
+                    auto it = std::lower_bound(blocked.begin(), blocked.end(), ny * width + nx);
+                    if (it == blocked.end() || *it != ny * width + nx)
+                        continue;
+                    const size_t k = it - blocked.begin();
+                    if (!grouped[k]) {
+                        grouped[k] = 1;
+                        group.push_back(static_cast<int>(k));
+                    }
+                }
+            }
+        }
+
+        if (mayCut(grid, minX, minY, maxX, maxY)) {
+            for (int k : group)
+                dirty[labels[blocked[k]]] = 1;
+            anyDirty = true;
+        }
+    }
+
+    for (int i : blocked)
+        labels[i] = -1;
+
+    std::vector<int> stack;
+    if (anyDirty) {
+        for (int& label : labels) {
+            if (label >= 0 && dirty[label])
+                label = unlabelled;
+        }
+        for (size_t i = 0; i < labels.size(); ++i) {
+            if (labels[i] == unlabelled)
+                labelFrom(static_cast<int>(i), next++, stack);
+        }
+    }
+
+    // Openings join every region they touch
+    std::vector<int> parents;
+    if (!opened.empty()) {
+        for (int i : opened)
+            labels[i] = next++;
+        parents.resize(next);
+        for (int l = 0; l < next; ++l)
+            parents[l] = l;
+
+        for (int i : opened) {
+            const int x = i % width;
+            const int y = i / width;
+            const int neighbours[4][2] = { { x - 1, y }, { x + 1, y }, { x, y - 1 }, { x, y + 1 } };
+            for (const auto& n : neighbours) {
+                const int other = componentAt(n[0], n[1]);
+                if (other >= 0)
+                    parents[findRoot(parents, other)] = findRoot(parents, labels[i]);
+            }
+        }
+    }
+
+    // Number the surviving regions densely again
+    std::vector<int> dense(next, -1);
+    componentCount = 0;
+    for (int& label : labels) {
+        if (label < 0)
+            continue;
+        const int root = parents.empty() ? label : findRoot(parents, label);
+        if (dense[root] < 0)
+            dense[root] = componentCount++;
+        label = dense[root];
+    }
+}
+
+void ComponentLabels::labelAll(const NavGrid& grid)
+{
+    labels.assign(static_cast<size_t>(width) * height, -1);
+    for (size_t i = 0; i < labels.size(); ++i) {
+        if (grid.clearanceAt(static_cast<int>(i)) >= entitySize)
+            labels[i] = unlabelled;
+    }
+
+    std::vector<int> stack;
+    componentCount = 0;
+    for (size_t i = 0; i < labels.size(); ++i) {
+        if (labels[i] == unlabelled)
+            labelFrom(static_cast<int>(i), componentCount++, stack);
+    }
+}
+
+void ComponentLabels::labelFrom(int seed, int label, std::vector<int>& stack)
+{
+    labels[seed] = label;
+    stack.assign(1, seed);
+    while (!stack.empty()) {
+        const int i = stack.back();
+        stack.pop_back();
+        const int x = i % width;
+        const int y = i / width;
+        const int neighbours[4] = { x > 0 ? i - 1 : -1, x + 1 < width ? i + 1 : -1, y > 0 ? i - width : -1, y + 1 < height ? i + width : -1 };
+        for (int n : neighbours) {
+            if (n >= 0 && labels[n] == unlabelled) {
+                labels[n] = label;
+                stack.push_back(n);
+            }
+        }
+    }
+}
+
+// A blocked rectangle cannot disconnect anything when it is solid and the
+// free tiles on the ring around it form one unbroken run: every route that
+// crossed it can go around instead.
+bool ComponentLabels::mayCut(const NavGrid& grid, int minX, int minY, int maxX, int maxY) const
+{
+    for (int y = minY; y <= maxY; ++y) {
+        for (int x = minX; x <= maxX; ++x) {
+            if (grid.isWalkable(x, y, entitySize))
+                return true;
+        }
+    }
+
+    // Walk the ring once, clockwise from its top-left corner, counting the runs of free tiles
+    const int left = minX - 1;
+    const int top = minY - 1;
+    const int right = maxX + 1;
+    const int bottom = maxY + 1;
+    int x = left;
+    int y = top;
+    int runs = 0;
+    bool previous = grid.isWalkable(left, top + 1, entitySize);
+    do {
+        const bool walkable = grid.isWalkable(x, y, entitySize);
+        if (walkable && !previous)
+            runs++;
+        previous = walkable;
+
+        if (y == top && x < right)
+            x++;
+        else if (x == right && y < bottom)
+            y++;
+        else if (y == bottom && x > left)
+            x--;
+        else
+            y--;
+    } while (x != left || y != top);
+    return runs > 1;
+}
+
+bool ComponentLabels::nearestTile(int component, int x, int y, int maxRadius, int& xNearest, int& yNearest) const
+{
+    long long best = LLONG_MAX;
+    auto consider = [&](int tx, int ty) {
+        if (componentAt(tx, ty) != component)
+            return;
+        const long long dx = tx - x;
+        const long long dy = ty - y;
+        if (dx * dx + dy * dy < best) {
+            best = dx * dx + dy * dy;
+            xNearest = tx;
+            yNearest = ty;
+        }
+    };
+
+    for (int r = 0; r <= maxRadius; ++r) {
+        // Every tile of this square and beyond is at least r away
+        if (static_cast<long long>(r) * r >= best)
+            break;
+        if (r == 0) {
+            consider(x, y);
+            continue;
+        }
+        for (int tx = x - r; tx <= x + r; ++tx) {
+            consider(tx, y - r);
+            consider(tx, y + r);
+        }
+        for (int ty = y - r + 1; ty <= y + r - 1; ++ty) {
+            consider(x - r, ty);
+            consider(x + r, ty);
+        }
+    }
+    return best != LLONG_MAX;
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include "NavGrid.h"
+#include <vector>
+
+// Connected regions of the walkable tiles for one entity size. Diagonal steps
+// never cut corners, so two tiles are connected exactly when a chain of
+// orthogonal steps joins them. With the labels, a query between regions is
+// known to fail in O(1), instead of after a search drains every reachable tile.
+class ComponentLabels {
+private:
+    int width = 0;
+    int height = 0;
+    int entitySize = 1;
+    unsigned gridSerial = 0;
+    int componentCount = 0;
+    std::vector<int> labels; // per tile, -1 where the entity does not fit
+
+    void labelAll(const NavGrid& grid);
+    void labelFrom(int seed, int label, std::vector<int>& stack);
+    bool mayCut(const NavGrid& grid, int minX, int minY, int maxX, int maxY) const;
+
+public:
+    ComponentLabels(const NavGrid& grid, int entitySize);
+    // Labels for a grid that differs from the previous one's only where the
+    // occupancy of changedTiles changed. Openings merge the regions around
+    // them; only a region a new obstacle may have cut in two is flooded again.
+    ComponentLabels(const NavGrid& grid, const ComponentLabels& previous, const std::vector<int>& changedTiles);
+    // Labels read back from baked data for a grid of the same map, one per tile as getLabels gives them
+    ComponentLabels(const NavGrid& grid, int entitySize, int componentCount, const int* labels);
+    ~ComponentLabels() = default;
+
+    bool covers(const NavGrid& grid, int entitySize) const
+    {
+        return grid.getSerial() == gridSerial && entitySize == this->entitySize;
+    }
+
+    int componentAt(int x, int y) const
+    {
+        return x >= 0 && x < width && y >= 0 && y < height ? labels[y * width + x] : -1;
+    }
+    bool connected(int xStart, int yStart, int xFinish, int yFinish) const
+    {
+        int component = componentAt(xStart, yStart);
+        return component >= 0 && component == componentAt(xFinish, yFinish);
+    }
+
+    // Tile of the component closest to (x, y) in a straight line, searched in
+    // growing squares out to maxRadius; false when there is none that close
+    bool nearestTile(int component, int x, int y, int maxRadius, int& xNearest, int& yNearest) const;
+
+    int getComponentCount() const { return componentCount; }
+    int getEntitySize() const { return entitySize; }
+    const std::vector<int>& getLabels() const { return labels; }
+};
@@ -0,0 +1,334 @@
+#include "../Headers/DStarLite.h"
+#include <algorithm>
+#include <climits>
+
+namespace {
+    const int Infinite = INT_MAX / 4;
+
+    int addCost(int a, int b)
+    {
+        return (a >= Infinite || b >= Infinite) ? Infinite : a + b;
+    }
+
+    enum SubtreeMark : unsigned char { Unknown, Inside, Outside, Visiting };
+}
+
+DStarLite::DStarLite(std::shared_ptr<Pathfinder> pathfinder, int entitySize)
+{
+    this->pathfinder = pathfinder;
+    this->entitySize = entitySize;
+}
+
+void DStarLite::reset()
+{
+    goal = -1;
+    start = -1;
+    openTiles.clear();
+    treeTiles.clear();
+}
+
+bool DStarLite::plan(int xStart, int yStart, int xFinish, int yFinish, std::vector<int>& route)
+{
+    route.clear();
+    expansions = 0;
+
+    // The map may have been regenerated with a different size
+    if (pathfinder->getMapWidth() != mapWidth || pathfinder->getMapHeight() != mapHeight) {
+        mapWidth = pathfinder->getMapWidth();
+        mapHeight = pathfinder->getMapHeight();
+        reset();
+    }
+
+    if (xStart < 0 || yStart < 0 || xStart >= mapWidth || yStart >= mapHeight)
+        return false;
+    if (!pathfinder->isWalkable(xFinish, yFinish, entitySize))
+        return false;
+
+    const int newStart = yStart * mapWidth + xStart;
+    const int newGoal = yFinish * mapWidth + xFinish;
+
+    if (goal < 0) {
+        start = newStart;
+        goal = newGoal;
+        initialize();
+    }
+    else {
+        // Old keys stay lower bounds once km grows by the distance the goal moved
+        if (newGoal != goal) {
+            km += heuristic(goal, newGoal);
+            goal = newGoal;
+        }
+
+        if (newStart != start) {
+            // Off the old tree there is nothing below the agent worth keeping
+            if (rhs[newStart] >= Infinite) {
+                start = newStart;
+                initialize();
+            }
+            else {
+                moveStart(newStart);
+            }
+        }
+    }
+
+    if (!computeShortestPath())
+        return false;
+
+    // Tree parents lead from the goal back to the agent
+    for (int current = goal; current >= 0; current = keys[current].parent) {
+        route.push_back(current);
+        if (current == start || route.size() > treeTiles.size())
+            break;
+    }
+
+    if (route.back() != start) {
+        route.clear();
+        return false;
+    }
+    std::reverse(route.begin(), route.end());
+    return true;
+}
+
+void DStarLite::tilesChanged(const std::vector<int>& tiles)
+{
+    if (goal < 0 || tiles.empty())
+        return;
+
+    if (pathfinder->getMapWidth() != mapWidth || pathfinder->getMapHeight() != mapHeight) {
+        reset();
+        return;
+    }
+
+    // A changed tile alters the clearance of every anchor tile whose footprint
+    // covers it, and so the cost of each edge into or diagonally past those anchors
+    for (int tile : tiles) {
+        int tx = tile % mapWidth;
+        int ty = tile / mapWidth;
+
+        for (int y = ty - entitySize; y <= ty + 1; ++y) {
+            for (int x = tx - entitySize; x <= tx + 1; ++x) {
+                if (x < 0 || y < 0 || x >= mapWidth || y >= mapHeight)
+                    continue;
+                int i = y * mapWidth + x;
+                if (i == start)
+                    continue;
+                updateRhs(i);
+                updateState(i);
+            }
+        }
+    }
+}
+
+void DStarLite::initialize()
+{
+    const size_t count = static_cast<size_t>(mapWidth) * mapHeight;
+    g.assign(count, Infinite);
+    rhs.assign(count, Infinite);
+    keys.assign(count, SearchNode());
+    inTree.assign(count, 0);
+    subtree.assign(count, Unknown);
+    treeTiles.clear();
+    openTiles.clear();
+
+    km = 0;
+    setRhs(start, 0, -1);
+    updateState(start);
+}
+
+bool DStarLite::computeShortestPath()
+{
+    while (!openTiles.empty()) {
+        const int goalSecond = (std::min)(g[goal], rhs[goal]);
+        const int goalFirst = addCost(goalSecond, km);
+        int top = openTiles.top();
+        if (!keyBefore(top, goalFirst, goalSecond) && rhs[goal] <= g[goal])
+            break;
+
+        // Keys computed before the goal moved are lower bounds, refresh and retry
+        const int oldFirst = keys[top].totalCost;
+        const int oldSecond = keys[top].finishCost;
+        setKey(top);
+        if (oldFirst < keys[top].totalCost ||
+            (oldFirst == keys[top].totalCost && oldSecond < keys[top].finishCost)) {
+            openTiles.update(keys, top);
+            continue;
+        }
+
+        openTiles.remove(keys, top);
+        ++expansions;
+
+        const bool lowered = g[top] > rhs[top];
+        if (lowered)
+            g[top] = rhs[top];
+        else {
+            g[top] = Infinite;
+            updateState(top);
+        }
+
+        const int x1 = top % mapWidth;
+        const int y1 = top / mapWidth;
+        for (int y = y1 - 1; y <= y1 + 1; ++y) {
+            for (int x = x1 - 1; x <= x1 + 1; ++x) {
+                if ((x == x1 && y == y1) || x < 0 || y < 0 || x >= mapWidth || y >= mapHeight)
+                    continue;
+
+                int i = y * mapWidth + x;
+                if (i == start)
+                    continue;
+
+                if (lowered) {
+                    int cost = addCost(g[top], moveCost(top, i));
+                    if (cost < rhs[i]) {
+                        setRhs(i, cost, top);
+                        updateState(i);
+                    }
+                }
+                else if (keys[i].parent == top) {
+                    updateRhs(i);
+                    updateState(i);
+                }
+            }
+        }
+    }
+
+    return rhs[goal] < Infinite;
+}
+
+// The agent stepped onto a tile of the old tree. Its subtree keeps its costs,
+// which all carry the same offset; every other tile is dropped and reseeded
+// from the kept tiles next to it.
+void DStarLite::moveStart(int newStart)
+{
+    start = newStart;
+    keys[start].parent = -1;
+
+    std::vector<int> chain;
+    for (int tile : treeTiles) {
+        int current = tile;
+        while (subtree[current] == Unknown) {
+            if (current == start) {
+                subtree[current] = Inside;
+                break;
+            }
+            subtree[current] = Visiting;
+            chain.push_back(current);
+            if (keys[current].parent < 0)
+                break;
+            current = keys[current].parent;
+        }
+
+        // A parent cycle or a root other than the agent cuts the chain off
+        unsigned char mark = subtree[current] == Inside ? Inside : Outside;
+        for (int i : chain)
+            subtree[i] = mark;
+        chain.clear();
+    }
+
+    std::vector<int> dropped;
+    size_t kept = 0;
+    for (int tile : treeTiles) {
+        bool inside = subtree[tile] == Inside;
+        subtree[tile] = Unknown;
+        if (inside) {
+            treeTiles[kept++] = tile;
+            continue;
+        }
+        g[tile] = Infinite;
+        rhs[tile] = Infinite;
+        keys[tile].parent = -1;
+        inTree[tile] = 0;
+        openTiles.remove(keys, tile);
+        dropped.push_back(tile);
+    }
+    treeTiles.resize(kept);
+
+    for (int tile : dropped) {
+        updateRhs(tile);
+        updateState(tile);
+    }
+}
+
+void DStarLite::updateState(int i)
+{
+    bool contains = keys[i].isOpen();
+    if (g[i] != rhs[i]) {
+        setKey(i);
+        if (contains)
+            openTiles.update(keys, i);
+        else
+            openTiles.push(keys, i);
+    }
+    else if (contains) {
+        openTiles.remove(keys, i);
+    }
+}
+
+void DStarLite::updateRhs(int i)
+{
+    const int x1 = i % mapWidth;
+    const int y1 = i / mapWidth;
+    int best = -1;
+    int cost = Infinite;
+
+    for (int y = y1 - 1; y <= y1 + 1; ++y) {
+        for (int x = x1 - 1; x <= x1 + 1; ++x) {
+            if ((x == x1 && y == y1) || x < 0 || y < 0 || x >= mapWidth || y >= mapHeight)
+                continue;
+
+            int previous = y * mapWidth + x;
+            int total = addCost(g[previous], moveCost(previous, i));
+            if (total < cost) {
+                cost = total;
+                best = previous;
+            }
+        }
+    }
+    setRhs(i, cost, best);
+}
+
+void DStarLite::setRhs(int i, int cost, int parent)
+{
+    rhs[i] = cost;
+    keys[i].parent = parent;
+    if (cost < Infinite && !inTree[i]) {
+        inTree[i] = 1;
+        treeTiles.push_back(i);
+    }
+}
+
+void DStarLite::setKey(int i)
+{
+    int m = (std::min)(g[i], rhs[i]);
+    keys[i].finishCost = m;
+    keys[i].totalCost = addCost(m, heuristic(i, goal) + km);
+}
+
+bool DStarLite::keyBefore(int i, int k1, int k2) const
+{
+    if (keys[i].totalCost != k1)
+        return keys[i].totalCost < k1;
+    return keys[i].finishCost < k2;
+}
+
+int DStarLite::moveCost(int from, int to) const
+{
+    const int x1 = from % mapWidth;
+    const int y1 = from / mapWidth;
+    const int x2 = to % mapWidth;
+    const int y2 = to / mapWidth;
+
+    if (!pathfinder->isWalkable(x2, y2, entitySize))
+        return Infinite;
+
+    // Same corner rule as the flat search
+    if (x1 != x2 && y1 != y2 &&
+        (!pathfinder->isWalkable(x1, y2, entitySize) || !pathfinder->isWalkable(x2, y1, entitySize)))
+        return Infinite;
+
+    return Pathfinder::phyt(x1, y1, x2, y2) * pathfinder->getWeight(x2, y2);
+}
+
+int DStarLite::heuristic(int a, int b) const
+{
+    return Pathfinder::phyt(a % mapWidth, a / mapWidth, b % mapWidth, b / mapWidth);
+}
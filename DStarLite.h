@@ -0,0 +1,68 @@
+#pragma once
+#include "Pathfinder.h"
+#include "SearchNode.h"
+#include "OpenList.h"
+#include <vector>
+#include <memory>
+
+// Incremental planner (Moving Target D* Lite) for one agent chasing a moving goal.
+// The search tree is rooted at the agent and grows towards the goal, so a goal
+// that moves only shifts the heuristic (km). When the agent steps along its path
+// the subtree below its new tile is kept and only the rest of the tree is
+// dropped; tiles that change between map versions repair just the edges they
+// touch. Costs match Pathfinder: octile steps times the weight of the tile
+// entered, no corner cutting, tiles walkable for the planner's entity size.
+class DStarLite {
+private:
+    std::shared_ptr<Pathfinder> pathfinder;
+    int entitySize;
+    int mapWidth = 0;
+    int mapHeight = 0;
+    unsigned mapVersion = 0;
+
+    std::vector<int> g;
+    std::vector<int> rhs;
+    // Queue keys (totalCost, finishCost) and tree parents, one per tile
+    std::vector<SearchNode> keys;
+    OpenList openTiles;
+
+    // Every tile with a finite rhs, so dropping part of the tree does not scan the map
+    std::vector<int> treeTiles;
+    std::vector<unsigned char> inTree;
+    std::vector<unsigned char> subtree;
+
+    int start = -1;
+    int goal = -1;
+    int km = 0;
+    size_t expansions = 0;
+
+    void initialize();
+    bool computeShortestPath();
+    void moveStart(int newStart);
+    void updateState(int i);
+    void updateRhs(int i);
+    void setRhs(int i, int cost, int parent);
+    void setKey(int i);
+    bool keyBefore(int i, int k1, int k2) const;
+    int moveCost(int from, int to) const;
+    int heuristic(int a, int b) const;
+
+public:
+    DStarLite(std::shared_ptr<Pathfinder> pathfinder, int entitySize = 1);
+    ~DStarLite() = default;
+
+    // Plan from start to finish, reusing the previous search where possible.
+    // Fills the raw tile route and returns false when the finish is unreachable.
+    bool plan(int xStart, int yStart, int xFinish, int yFinish, std::vector<int>& route);
+    // Tiles whose collision flag or weight changed since the last plan
+    void tilesChanged(const std::vector<int>& tiles);
+    // Drop all search state, the next plan searches from scratch
+    void reset();
+
+    const std::shared_ptr<Pathfinder>& getPathfinder() const { return pathfinder; }
+    int getEntitySize() const { return entitySize; }
+    unsigned getMapVersion() const { return mapVersion; }
+    void setMapVersion(unsigned version) { mapVersion = version; }
+    // Tiles expanded by the last plan call
+    size_t getExpansions() const { return expansions; }
+};
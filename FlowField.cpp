@@ -0,0 +1,67 @@
+#include "../Headers/FlowField.h"
+
+const int FlowField::neighbourOffsets[8][2] = {
+    { 1, 0 }, { 1, 1 }, { 0, 1 }, { -1, 1 }, { -1, 0 }, { -1, -1 }, { 0, -1 }, { 1, -1 }
+};
+
+FlowField::FlowField(Pathfinder& pathfinder, int xGoal, int yGoal, unsigned mapVersion)
+{
+    this->mapWidth = pathfinder.getMapWidth();
+    this->mapHeight = pathfinder.getMapHeight();
+    this->xGoal = xGoal;
+    this->yGoal = yGoal;
+    this->entitySize = pathfinder.getEntitySize();
+    this->mapVersion = mapVersion;
+
+    const size_t count = static_cast<size_t>(mapWidth) * mapHeight;
+    costs.assign(count, -1);
+    directions.assign(count, -1);
+
+    if (count == 0 || !pathfinder.isWalkable(xGoal, yGoal))
+        return;
+
+    // Reverse flood: costs are those of walking from each tile to the goal,
+    // and each tile's parent is the next tile on that walk
+    pathfinder.floodRegion(xGoal, yGoal, pathfinder.fullRegion(), true);
+
+    for (int y = 0; y < mapHeight; ++y) {
+        for (int x = 0; x < mapWidth; ++x) {
+            int i = y * mapWidth + x;
+            costs[i] = pathfinder.costTo(x, y);
+
+            int next = pathfinder.parentOf(x, y);
+            if (next < 0)
+                continue;
+
+            int dx = next % mapWidth - x;
+            int dy = next / mapWidth - y;
+            for (int d = 0; d < 8; ++d) {
+                if (neighbourOffsets[d][0] == dx && neighbourOffsets[d][1] == dy) {
+                    directions[i] = static_cast<signed char>(d);
+                    break;
+                }
+            }
+        }
+    }
+}
+
+int FlowField::getCost(int x, int y) const
+{
+    if (x < 0 || y < 0 || x >= mapWidth || y >= mapHeight)
+        return -1;
+    return costs[y * mapWidth + x];
+}
+
+bool FlowField::getDirection(int x, int y, int& dx, int& dy) const
+{
+    if (x < 0 || y < 0 || x >= mapWidth || y >= mapHeight)
+        return false;
+
+    int d = directions[y * mapWidth + x];
+    if (d < 0)
+        return false;
+
+    dx = neighbourOffsets[d][0];
+    dy = neighbourOffsets[d][1];
+    return true;
+}
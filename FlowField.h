@@ -0,0 +1,36 @@
+#pragma once
+#include "Pathfinder.h"
+#include <vector>
+
+// Goal-centric flow field over a Pathfinder map.
+// One reverse Dijkstra pass from the goal gives every tile its cost to the
+// goal (the integration field) and the neighbour to step to next (the
+// direction field), so any number of agents can sample it in O(1).
+class FlowField {
+private:
+    int mapWidth = 0;
+    int mapHeight = 0;
+    int xGoal = 0;
+    int yGoal = 0;
+    int entitySize = 1;
+    unsigned mapVersion = 0;
+
+    std::vector<int> costs;                 // -1 where the goal cannot be reached
+    std::vector<signed char> directions;    // index into neighbourOffsets, -1 for none
+
+public:
+    static const int neighbourOffsets[8][2];
+
+    // For agents of the pathfinder's entity size, the goal is the top-left tile of their footprint
+    FlowField(Pathfinder& pathfinder, int xGoal, int yGoal, unsigned mapVersion);
+    ~FlowField() = default;
+
+    int getCost(int x, int y) const;
+    // Step to take from (x, y) towards the goal; false at the goal or when unreachable
+    bool getDirection(int x, int y, int& dx, int& dy) const;
+
+    int getGoalX() const { return xGoal; }
+    int getGoalY() const { return yGoal; }
+    int getEntitySize() const { return entitySize; }
+    unsigned getMapVersion() const { return mapVersion; }
+};
@@ -0,0 +1,511 @@
+#include "../Headers/HierarchicalMap.h"
+#include <algorithm>
+
+HierarchicalMap::HierarchicalMap(std::shared_ptr<Pathfinder> pathfinder, int clusterSize)
+{
+    this->pathfinder = pathfinder;
+    this->clusterSize = (std::max)(clusterSize, 2);
+}
+
+void HierarchicalMap::build()
+{
+    graph.clear();
+    clusterNodes.clear();
+    tileNodes.clear();
+
+    mapWidth = pathfinder->getMapWidth();
+    mapHeight = pathfinder->getMapHeight();
+    entitySize = pathfinder->getEntitySize();
+    if (mapWidth <= 0 || mapHeight <= 0)
+        return;
+
+    clustersX = (mapWidth + clusterSize - 1) / clusterSize;
+    clustersY = (mapHeight + clusterSize - 1) / clusterSize;
+    clusterNodes.resize(static_cast<size_t>(clustersX) * clustersY);
+
+    // 1) entrances on every border between two clusters
+    for (int cy = 0; cy < clustersY; ++cy) {
+        for (int cx = 0; cx < clustersX; ++cx) {
+            if (cx + 1 < clustersX)
+                addEntrances((cx + 1) * clusterSize - 1, cy * clusterSize, true);
+            if (cy + 1 < clustersY)
+                addEntrances(cx * clusterSize, (cy + 1) * clusterSize - 1, false);
+        }
+    }
+
+    // 2) cheapest routes between the entrances of each cluster
+    for (int c = 0; c < static_cast<int>(clusterNodes.size()); ++c)
+        connectCluster(c);
+
+    searchNodes.assign(graph.size() + 2, SearchNode());
+    finishCosts.assign(graph.size(), -1);
+    generation = 0;
+}
+
+void HierarchicalMap::update(const std::vector<int>& changedTiles)
+{
+    if (mapWidth != pathfinder->getMapWidth() || mapHeight != pathfinder->getMapHeight() ||
+        entitySize != pathfinder->getEntitySize() || clusterNodes.empty()) {
+        build();
+        return;
+    }
+    if (changedTiles.empty())
+        return;
+
+    // A changed tile decides whether footprints up to entitySize - 1 tiles up and
+    // left of it fit. Each cluster has a border to its right and one below.
+    const int clusterCount = static_cast<int>(clusterNodes.size());
+    std::vector<char> affected(clusterCount, 0);
+    std::vector<char> dirtyBorders(static_cast<size_t>(clusterCount) * 2, 0);
+    for (int tile : changedTiles) {
+        const int maxX = tile % mapWidth;
+        const int maxY = tile / mapWidth;
+        const int minX = (std::max)(0, maxX - entitySize + 1);
+        const int minY = (std::max)(0, maxY - entitySize + 1);
+
+        for (int cy = (std::max)(0, minY - 1) / clusterSize; cy <= maxY / clusterSize; ++cy) {
+            for (int cx = (std::max)(0, minX - 1) / clusterSize; cx <= maxX / clusterSize; ++cx) {
+                const int cluster = cy * clustersX + cx;
+                const int left = cx * clusterSize;
+                const int top = cy * clusterSize;
+                const int right = left + clusterSize - 1;
+                const int bottom = top + clusterSize - 1;
+                const bool rowsOverlap = minY <= bottom && maxY >= top;
+                const bool columnsOverlap = minX <= right && maxX >= left;
+                if (rowsOverlap && columnsOverlap)
+                    affected[cluster] = 1;
+                // A border is the last line of this cluster and the first of the next
+                if (cx + 1 < clustersX && rowsOverlap && minX <= right + 1 && maxX >= right)
+                    dirtyBorders[cluster * 2] = 1;
+                if (cy + 1 < clustersY && columnsOverlap && minY <= bottom + 1 && maxY >= bottom)
+                    dirtyBorders[cluster * 2 + 1] = 1;
+            }
+        }
+    }
+    for (int cluster = 0; cluster < clusterCount; ++cluster) {
+        if (dirtyBorders[cluster * 2])
+            affected[cluster] = affected[cluster + 1] = 1;
+        if (dirtyBorders[cluster * 2 + 1])
+            affected[cluster] = affected[cluster + clustersX] = 1;
+    }
+
+    // Nodes survive while they have a transition across a clean border. Routes
+    // are kept in clusters nothing touched, whose nodes all survive.
+    std::vector<Node> previous;
+    previous.swap(graph);
+    tileNodes.clear();
+    for (auto& members : clusterNodes)
+        members.clear();
+
+    auto cleanTransition = [&](const Node& node, const Edge& edge) {
+        const int other = previous[edge.to].cluster;
+        return other != node.cluster && !dirtyBorders[borderBetween(node.cluster, other)];
+    };
+    std::vector<int> renamed(previous.size(), -1);
+    for (size_t n = 0; n < previous.size(); ++n) {
+        for (const Edge& edge : previous[n].edges) {
+            if (cleanTransition(previous[n], edge)) {
+                renamed[n] = addNode(previous[n].x, previous[n].y);
+                break;
+            }
+        }
+    }
+    for (size_t n = 0; n < previous.size(); ++n) {
+        if (renamed[n] < 0)
+            continue;
+        const bool keepRoutes = !affected[previous[n].cluster];
+        for (const Edge& edge : previous[n].edges) {
+            const bool transition = previous[edge.to].cluster != previous[n].cluster;
+            if (renamed[edge.to] >= 0 && (transition ? cleanTransition(previous[n], edge) : keepRoutes))
+                graph[renamed[n]].edges.push_back(Edge{ renamed[edge.to], edge.cost });
+        }
+    }
+
+    for (int cluster = 0; cluster < clusterCount; ++cluster) {
+        const int left = (cluster % clustersX) * clusterSize;
+        const int top = (cluster / clustersX) * clusterSize;
+        if (dirtyBorders[cluster * 2])
+            addEntrances(left + clusterSize - 1, top, true);
+        if (dirtyBorders[cluster * 2 + 1])
+            addEntrances(left, top + clusterSize - 1, false);
+    }
+    for (int cluster = 0; cluster < clusterCount; ++cluster) {
+        if (affected[cluster])
+            connectCluster(cluster);
+    }
+
+    searchNodes.assign(graph.size() + 2, SearchNode());
+    finishCosts.assign(graph.size(), -1);
+    generation = 0;
+}
+
+void HierarchicalMap::saveGraph(std::vector<int>& nodeData, std::vector<int>& edgeData) const
+{
+    nodeData.clear();
+    edgeData.clear();
+    for (const Node& node : graph) {
+        nodeData.insert(nodeData.end(), { node.x, node.y, static_cast<int>(node.edges.size()) });
+        for (const Edge& edge : node.edges)
+            edgeData.insert(edgeData.end(), { edge.to, edge.cost });
+    }
+}
+
+bool HierarchicalMap::loadGraph(const int* nodeData, int nodeCount, const int* edgeData, int edgeCount)
+{
+    // The map and its clusters as build() would lay them out
+    graph.clear();
+    clusterNodes.clear();
+    tileNodes.clear();
+    mapWidth = pathfinder->getMapWidth();
+    mapHeight = pathfinder->getMapHeight();
+    entitySize = pathfinder->getEntitySize();
+    if (mapWidth <= 0 || mapHeight <= 0)
+        return false;
+    clustersX = (mapWidth + clusterSize - 1) / clusterSize;
+    clustersY = (mapHeight + clusterSize - 1) / clusterSize;
+    clusterNodes.resize(static_cast<size_t>(clustersX) * clustersY);
+
+    bool valid = true;
+    int nextEdge = 0;
+    for (int n = 0; n < nodeCount && valid; ++n) {
+        const int* data = &nodeData[n * 3];
+        valid = data[0] >= 0 && data[0] < mapWidth && data[1] >= 0 && data[1] < mapHeight &&
+            data[2] >= 0 && data[2] <= edgeCount - nextEdge && addNode(data[0], data[1]) == n;
+        for (int e = 0; valid && e < data[2]; ++e, ++nextEdge) {
+            const int to = edgeData[nextEdge * 2];
+            valid = to >= 0 && to < nodeCount;
+            if (valid)
+                graph[n].edges.push_back({ to, edgeData[nextEdge * 2 + 1] });
+        }
+    }
+    if (!valid || nextEdge != edgeCount) {
+        graph.clear();
+        clusterNodes.clear();
+        tileNodes.clear();
+        return false;
+    }
+
+    searchNodes.assign(graph.size() + 2, SearchNode());
+    finishCosts.assign(graph.size(), -1);
+    generation = 0;
+    return true;
+}
+
+std::vector<std::shared_ptr<AstarTile>>
+HierarchicalMap::newPath(int xStart, int yStart, int xFinish, int yFinish)
+{
+    if (graph.empty() && clusterNodes.empty())
+        return pathfinder->newPath(xStart, yStart, xFinish, yFinish);
+
+    if (!pathfinder->isWalkable(xFinish, yFinish))
+        return {};
+
+    if (xStart < 0 || yStart < 0 || xStart >= mapWidth || yStart >= mapHeight)
+        return {};
+
+    if (xStart == xFinish && yStart == yFinish)
+        return { std::make_shared<AstarTile>(xStart, yStart, false) };
+
+    std::vector<int> route;
+    if (pathfinder->isWalkable(xStart, yStart)) {
+        if (!findRoute(xStart, yStart, xFinish, yFinish, route))
+            return {};
+        return pathfinder->smoothRoute(route);
+    }
+
+    // An agent standing on a blocked tile steps out first, like it can in the
+    // flat search. Neighbours closest to the finish are tried first.
+    std::vector<std::pair<int, int>> exits;
+    for (int dy = -1; dy <= 1; ++dy) {
+        for (int dx = -1; dx <= 1; ++dx) {
+            int x = xStart + dx;
+            int y = yStart + dy;
+            if ((dx == 0 && dy == 0) || !pathfinder->isWalkable(x, y))
+                continue;
+            if (dx != 0 && dy != 0 &&
+                (!pathfinder->isWalkable(xStart + dx, yStart) || !pathfinder->isWalkable(xStart, yStart + dy)))
+                continue;
+            exits.push_back({ Pathfinder::phyt(xStart, yStart, x, y) + Pathfinder::phyt(x, y, xFinish, yFinish), y * mapWidth + x });
+        }
+    }
+    std::sort(exits.begin(), exits.end());
+
+    for (const auto& exit : exits) {
+        route.clear();
+        if (findRoute(exit.second % mapWidth, exit.second / mapWidth, xFinish, yFinish, route)) {
+            route.insert(route.begin(), yStart * mapWidth + xStart);
+            return pathfinder->smoothRoute(route);
+        }
+    }
+    return {};
+}
+
+bool HierarchicalMap::findRoute(int xStart, int yStart, int xFinish, int yFinish, std::vector<int>& route)
+{
+    if (xStart == xFinish && yStart == yFinish) {
+        route.push_back(yStart * mapWidth + xStart);
+        return true;
+    }
+
+    // Short queries inside one cluster never need the abstract graph
+    int startCluster = clusterOf(xStart, yStart);
+    if (startCluster == clusterOf(xFinish, yFinish) &&
+        pathfinder->searchRegion(xStart, yStart, xFinish, yFinish, clusterRegion(startCluster), &route) >= 0)
+        return true;
+
+    std::vector<int> abstractPath = searchAbstract(xStart, yStart, xFinish, yFinish);
+    if (abstractPath.empty())
+        return false;
+
+    route.clear();
+    return refine(abstractPath, route);
+}
+
+int HierarchicalMap::clusterOf(int x, int y) const
+{
+    return (y / clusterSize) * clustersX + (x / clusterSize);
+}
+
+int HierarchicalMap::borderBetween(int clusterA, int clusterB) const
+{
+    // Neighbours a row apart share the upper one's bottom border, the others its right one
+    const int first = (std::min)(clusterA, clusterB);
+    return first * 2 + ((std::max)(clusterA, clusterB) - first == clustersX ? 1 : 0);
+}
+
+Pathfinder::Region HierarchicalMap::clusterRegion(int cluster) const
+{
+    Pathfinder::Region region;
+    region.minX = (cluster % clustersX) * clusterSize;
+    region.minY = (cluster / clustersX) * clusterSize;
+    region.maxX = (std::min)(region.minX + clusterSize, mapWidth) - 1;
+    region.maxY = (std::min)(region.minY + clusterSize, mapHeight) - 1;
+    return region;
+}
+
+int HierarchicalMap::addNode(int x, int y)
+{
+    int tile = y * mapWidth + x;
+    auto it = tileNodes.find(tile);
+    if (it != tileNodes.end())
+        return it->second;
+
+    int id = static_cast<int>(graph.size());
+    graph.push_back(Node{ x, y, clusterOf(x, y), {} });
+    clusterNodes[graph.back().cluster].push_back(id);
+    tileNodes[tile] = id;
+    return id;
+}
+
+// Scans the border that starts at (xBorder, yBorder) on the near side.
+// Vertical borders run down a column and are crossed in +x, horizontal
+// borders run along a row and are crossed in +y.
+void HierarchicalMap::addEntrances(int xBorder, int yBorder, bool vertical)
+{
+    const int dx = vertical ? 1 : 0;
+    const int dy = vertical ? 0 : 1;
+    const int length = vertical
+        ? (std::min)(yBorder + clusterSize, mapHeight) - yBorder
+        : (std::min)(xBorder + clusterSize, mapWidth) - xBorder;
+
+    auto open = [&](int i) {
+        int x = xBorder + (vertical ? 0 : i);
+        int y = yBorder + (vertical ? i : 0);
+        return pathfinder->isWalkable(x, y) && pathfinder->isWalkable(x + dx, y + dy);
+    };
+
+    auto addTransition = [&](int i) {
+        int x = xBorder + (vertical ? 0 : i);
+        int y = yBorder + (vertical ? i : 0);
+        int nearNode = addNode(x, y);
+        int farNode = addNode(x + dx, y + dy);
+        graph[nearNode].edges.push_back(Edge{ farNode, 10 * pathfinder->getWeight(x + dx, y + dy) });
+        graph[farNode].edges.push_back(Edge{ nearNode, 10 * pathfinder->getWeight(x, y) });
+    };
+
+    int i = 0;
+    while (i < length) {
+        if (!open(i)) {
+            ++i;
+            continue;
+        }
+
+        int first = i;
+        while (i < length && open(i))
+            ++i;
+        int last = i - 1;
+
+        // Long entrances get a transition at each end, short ones in the middle
+        if (last - first + 1 >= 6) {
+            addTransition(first);
+            addTransition(last);
+        }
+        else {
+            addTransition((first + last) / 2);
+        }
+    }
+}
+
+void HierarchicalMap::connectCluster(int cluster)
+{
+    const auto& members = clusterNodes[cluster];
+    if (members.size() < 2)
+        return;
+
+    // With uniform weights a route costs the same both ways, so each pair
+    // only needs one flood
+    const bool symmetric = pathfinder->hasUniformWeights();
+    const Pathfinder::Region region = clusterRegion(cluster);
+
+    for (size_t i = 0; i < members.size(); ++i) {
+        if (symmetric && i + 1 == members.size())
+            break;
+
+        int from = members[i];
+        pathfinder->floodRegion(graph[from].x, graph[from].y, region, false);
+
+        for (size_t j = symmetric ? i + 1 : 0; j < members.size(); ++j) {
+            int to = members[j];
+            if (to == from)
+                continue;
+            int cost = pathfinder->costTo(graph[to].x, graph[to].y);
+            if (cost < 0)
+                continue;
+            graph[from].edges.push_back(Edge{ to, cost });
+            if (symmetric)
+                graph[to].edges.push_back(Edge{ from, cost });
+        }
+    }
+}
+
+std::vector<int> HierarchicalMap::searchAbstract(int xStart, int yStart, int xFinish, int yFinish)
+{
+    const int nodeCount = static_cast<int>(graph.size());
+    const int startNode = nodeCount;
+    const int finishNode = nodeCount + 1;
+    const int startCluster = clusterOf(xStart, yStart);
+    const int finishCluster = clusterOf(xFinish, yFinish);
+
+    // Hook the start and finish into the entrances of their own clusters
+    startEdges.clear();
+    pathfinder->floodRegion(xStart, yStart, clusterRegion(startCluster), false);
+    for (int id : clusterNodes[startCluster]) {
+        int cost = pathfinder->costTo(graph[id].x, graph[id].y);
+        if (cost >= 0)
+            startEdges.push_back(Edge{ id, cost });
+    }
+
+    pathfinder->floodRegion(xFinish, yFinish, clusterRegion(finishCluster), true);
+    for (int id : clusterNodes[finishCluster])
+        finishCosts[id] = pathfinder->costTo(graph[id].x, graph[id].y);
+
+    if (++generation == 0) {
+        for (auto& n : searchNodes)
+            n.generation = 0;
+        generation = 1;
+    }
+    openNodes.clear();
+
+    auto position = [&](int id, int& x, int& y) {
+        if (id == startNode) { x = xStart; y = yStart; }
+        else if (id == finishNode) { x = xFinish; y = yFinish; }
+        else { x = graph[id].x; y = graph[id].y; }
+    };
+
+    auto touch = [&](int id) -> SearchNode& {
+        SearchNode& n = searchNodes[id];
+        if (n.generation != generation) {
+            int x, y;
+            position(id, x, y);
+            n = SearchNode();
+            n.generation = generation;
+            n.finishCost = Pathfinder::phyt(x, y, xFinish, yFinish);
+            n.totalCost = n.finishCost;
+        }
+        return n;
+    };
+
+    auto relax = [&](int from, int to, int cost) {
+        SearchNode& t = touch(to);
+        if (t.closed)
+            return;
+
+        int newCost = searchNodes[from].startCost + cost;
+        bool contains = t.isOpen();
+        if (!contains || t.startCost > newCost) {
+            t.startCost = newCost;
+            t.totalCost = t.startCost + t.finishCost;
+            t.parent = from;
+        }
+
+        if (!contains)
+            openNodes.push(searchNodes, to);
+        else
+            openNodes.decrease(searchNodes, to);
+    };
+
+    touch(startNode);
+    int current = startNode;
+    bool found = false;
+
+    while (current >= 0) {
+        searchNodes[current].closed = true;
+        if (current == finishNode) {
+            found = true;
+            break;
+        }
+
+        if (current == startNode) {
+            for (const Edge& e : startEdges)
+                relax(current, e.to, e.cost);
+        }
+        else {
+            for (const Edge& e : graph[current].edges)
+                relax(current, e.to, e.cost);
+            if (graph[current].cluster == finishCluster && finishCosts[current] >= 0)
+                relax(current, finishNode, finishCosts[current]);
+        }
+
+        current = openNodes.pop(searchNodes);
+    }
+
+    for (int id : clusterNodes[finishCluster])
+        finishCosts[id] = -1;
+
+    std::vector<int> abstractPath;
+    if (!found)
+        return abstractPath;
+
+    for (int id = finishNode; id >= 0; id = searchNodes[id].parent) {
+        int x, y;
+        position(id, x, y);
+        abstractPath.push_back(y * mapWidth + x);
+    }
+    std::reverse(abstractPath.begin(), abstractPath.end());
+    return abstractPath;
+}
+
+bool HierarchicalMap::refine(const std::vector<int>& abstractPath, std::vector<int>& route)
+{
+    route.push_back(abstractPath.front());
+
+    std::vector<int> segment;
+    for (size_t i = 0; i + 1 < abstractPath.size(); ++i) {
+        int ax = abstractPath[i] % mapWidth;
+        int ay = abstractPath[i] / mapWidth;
+        int bx = abstractPath[i + 1] % mapWidth;
+        int by = abstractPath[i + 1] / mapWidth;
+
+        // Border crossings are a single step
+        int cluster = clusterOf(ax, ay);
+        if (cluster != clusterOf(bx, by)) {
+            route.push_back(abstractPath[i + 1]);
+            continue;
+        }
+
+        if (pathfinder->searchRegion(ax, ay, bx, by, clusterRegion(cluster), &segment) < 0)
+            return false;
+        route.insert(route.end(), segment.begin() + 1, segment.end());
+    }
+    return true;
+}
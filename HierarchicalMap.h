@@ -0,0 +1,80 @@
+#pragma once
+#include "Pathfinder.h"
+#include "SearchNode.h"
+#include "OpenList.h"
+#include <vector>
+#include <memory>
+#include <unordered_map>
+
+// HPA*-style abstraction over the tile map of a Pathfinder.
+// The map is cut into square clusters. Entrances along shared cluster borders
+// become abstract nodes, linked by single steps across the border and by the
+// cheapest routes inside each cluster, which are computed once in build().
+// A query searches this graph first and then only refines the clusters the
+// abstract path runs through.
+class HierarchicalMap {
+private:
+    struct Edge {
+        int to;
+        int cost;
+    };
+
+    struct Node {
+        int x;
+        int y;
+        int cluster;
+        std::vector<Edge> edges;
+    };
+
+    std::shared_ptr<Pathfinder> pathfinder;
+    int clusterSize;
+    int entitySize = 1;
+    int clustersX = 0;
+    int clustersY = 0;
+    int mapWidth = 0;
+    int mapHeight = 0;
+
+    std::vector<Node> graph;
+    std::vector<std::vector<int>> clusterNodes;
+    std::unordered_map<int, int> tileNodes;
+
+    // Abstract search state, the two extra nodes are the query's start and finish
+    std::vector<SearchNode> searchNodes;
+    unsigned generation = 0;
+    OpenList openNodes;
+    std::vector<Edge> startEdges;
+    std::vector<int> finishCosts;
+
+    int clusterOf(int x, int y) const;
+    int borderBetween(int clusterA, int clusterB) const; // index into the per-cluster right and bottom borders
+    Pathfinder::Region clusterRegion(int cluster) const;
+    int addNode(int x, int y);
+    void addEntrances(int xBorder, int yBorder, bool vertical);
+    void connectCluster(int cluster);
+    bool findRoute(int xStart, int yStart, int xFinish, int yFinish, std::vector<int>& route);
+    std::vector<int> searchAbstract(int xStart, int yStart, int xFinish, int yFinish);
+    bool refine(const std::vector<int>& abstractPath, std::vector<int>& route);
+
+public:
+    HierarchicalMap(std::shared_ptr<Pathfinder> pathfinder, int clusterSize = 16);
+    ~HierarchicalMap() = default;
+
+    // Rebuild clusters, entrances and intra-cluster edges for the current map
+    void build();
+    // Catch up with tiles (y * width + x) whose occupancy changed since the last
+    // build or update: entrances are found again only on the borders those tiles
+    // lie on, and routes only inside the clusters they or those borders touch
+    void update(const std::vector<int>& changedTiles);
+    // Flat copy of the abstract graph for baking: x, y and edge count per node,
+    // then target and cost per edge, nodes in order
+    void saveGraph(std::vector<int>& nodeData, std::vector<int>& edgeData) const;
+    // Adopt a graph saved from a hierarchy of the same map instead of building one;
+    // false, leaving the hierarchy empty, when the data does not fit the map
+    bool loadGraph(const int* nodeData, int nodeCount, const int* edgeData, int edgeCount);
+    std::vector<std::shared_ptr<AstarTile>> newPath(int xStart, int yStart, int xFinish, int yFinish);
+
+    size_t getNodeCount() const { return graph.size(); }
+    int getClusterSize() const { return clusterSize; }
+    // Entity size the pathfinder was set to when the hierarchy was built
+    int getEntitySize() const { return entitySize; }
+};
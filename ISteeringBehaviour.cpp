@@ -0,0 +1,67 @@
+#include "../Headers/ISteeringBehaviour.h"
+#include "../Headers/CollisionMap.h"
+
+std::vector<std::shared_ptr<Vector2>> ISteeringBehaviour::GetPath(const Vector2& start, const Vector2& end, float agentSize) {
+	if (agentSize > 0.0f) {
+		if (auto collisionMap = GetCollisionMap())
+			return collisionMap->GetPath(std::make_shared<Vector2>(start), std::make_shared<Vector2>(end), agentSize);
+	}
+	Engine& e = Engine::instance();
+	if (auto physicsSystem = e.GetSystem<PhysicsSystem>()) {
+		return physicsSystem->GetPath(std::make_shared<Vector2>(start), std::make_shared<Vector2>(end));
+	}
+	return {};
+}
+
+bool ISteeringBehaviour::GetPath(const Vector2& start, const Vector2& end, std::vector<Vector2>& path, float agentSize) {
+	path.clear();
+	if (auto collisionMap = GetCollisionMap())
+		return collisionMap->GetPath(start, end, path, agentSize);
+	for (const auto& point : GetPath(start, end, agentSize))
+		path.push_back(*point);
+	return !path.empty();
+}
+
+std::vector<std::shared_ptr<Vector2>> ISteeringBehaviour::GetPath(const Vector2& start, const Vector2& end, std::shared_ptr<DStarLite>& planner, float agentSize) {
+	if (auto collisionMap = GetCollisionMap())
+		return collisionMap->GetPath(start, end, planner, agentSize);
+	return {};
+}
+
+bool ISteeringBehaviour::GetPath(const Vector2& start, const Vector2& end, std::shared_ptr<DStarLite>& planner, std::vector<Vector2>& path, float agentSize) {
+	path.clear();
+	if (auto collisionMap = GetCollisionMap())
+		return collisionMap->GetPath(start, end, planner, path, agentSize);
+	return false;
+}
+
+unsigned ISteeringBehaviour::RequestPath(const Vector2& start, const Vector2& end, float agentSize, std::function<void(std::vector<std::shared_ptr<Vector2>>)> callback) {
+	if (auto collisionMap = GetCollisionMap())
+		return collisionMap->RequestPath(start, end, agentSize, std::move(callback));
+	return 0;
+}
+
+unsigned ISteeringBehaviour::RequestPathInto(const Vector2& start, const Vector2& end, float agentSize, std::function<void(const std::vector<Vector2>&)> callback) {
+	if (auto collisionMap = GetCollisionMap())
+		return collisionMap->RequestPathInto(start, end, agentSize, std::move(callback));
+	return 0;
+}
+
+bool ISteeringBehaviour::IsPathRequestPending(unsigned request) {
+	if (auto collisionMap = GetCollisionMap())
+		return collisionMap->IsPathRequestPending(request);
+	return false;
+}
+
+bool ISteeringBehaviour::GetFlowDirection(const Vector2& position, const Vector2& goal, Vector2& direction, float agentSize) {
+	if (auto collisionMap = GetCollisionMap())
+		return collisionMap->GetFlowDirection(position, goal, direction, agentSize);
+	return false;
+}
+
+std::shared_ptr<CollisionMap> ISteeringBehaviour::GetCollisionMap() {
+	Engine& e = Engine::instance();
+	if (auto aiSystem = e.GetSystem<AISystem>())
+		return aiSystem->GetCollisionMap();
+	return nullptr;
+}
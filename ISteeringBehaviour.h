@@ -1,51 +1,93 @@
-/// @file ISteeringBehaviour.h
-/// @brief Base interface for steering behaviours
-
-#pragma once
-
-#include "Vector2.h"
-#include "AIAgent.h"
-#include "SteeringContext.h"
-#include "AISystem.h"
-#include "Engine.h"
-#include "PhysicsSystem.h"
-#include <memory>
-#include <vector>
-#include <list>
-
-class Collider;
-
-/// @brief Abstract interface for steering behaviours
-class ISteeringBehaviour {
-public:
-	/// @brief Virtual destructor for proper cleanup
-	virtual ~ISteeringBehaviour() = default;
-
-	/// @brief Update the behaviour on execution
-	/// @details returns the steering force as a Vector2
-	virtual Vector2 Execute(const std::shared_ptr<SteeringContext> context) = 0;
-
-	/// @brief Get all agents in the scene
-	std::vector<std::shared_ptr<AIAgent>> GetAgents() {
-		Engine& e = Engine::instance();
-		auto aiSystem = e.GetSystem<AISystem>();
-		return aiSystem->GetAllAgents();
-	}
-
-	/// @brief Get all colliders in the scene
-	std::list<std::shared_ptr<Collider>> GetColliders() {
-		Engine& e = Engine::instance();
-		if (auto physicsSystem = e.GetSystem<PhysicsSystem>())
-			return physicsSystem->GetColliders();
-		return {};
-	}
-
-	/// @brief Get path in the scene
-	std::vector<std::shared_ptr<Vector2>> GetPath(const Vector2& start, const Vector2& end) {
-		Engine& e = Engine::instance();
-		if (auto physicsSystem = e.GetSystem<PhysicsSystem>()) {
-			return physicsSystem->GetPath(std::make_shared<Vector2>(start), std::make_shared<Vector2>(end));
-		}
-		return {};
-	}
+/// @file ISteeringBehaviour.h
+/// @brief Base interface for steering behaviours
+
+#pragma once
+
+#ifdef ENGINE_EXPORTS
+#define ENGINE_API __declspec(dllexport)
+#else
+#define ENGINE_API __declspec(dllimport)
+#endif
+
+#include "Vector2.h"
+#include "AIAgent.h"
+#include "SteeringContext.h"
+#include "AISystem.h"
+#include "Engine.h"
+#include "PhysicsSystem.h"
+#include <memory>
+#include <vector>
+#include <list>
+#include <functional>
+
+class Collider;
+class CollisionMap;
+class DStarLite;
+
+/// @brief Abstract interface for steering behaviours
+class ENGINE_API ISteeringBehaviour {
+public:
+	/// @brief Virtual destructor for proper cleanup
+	virtual ~ISteeringBehaviour() = default;
+
+	/// @brief Update the behaviour on execution
+	/// @details returns the steering force as a Vector2
+	virtual Vector2 Execute(const std::shared_ptr<SteeringContext> context) = 0;
+
+	/// @brief Get all agents in the scene
+	std::vector<std::shared_ptr<AIAgent>> GetAgents() {
+		Engine& e = Engine::instance();
+		auto aiSystem = e.GetSystem<AISystem>();
+		return aiSystem->GetAllAgents();
+	}
+
+	/// @brief Get all colliders in the scene
+	std::list<std::shared_ptr<Collider>> GetColliders() {
+		Engine& e = Engine::instance();
+		if (auto physicsSystem = e.GetSystem<PhysicsSystem>())
+			return physicsSystem->GetColliders();
+		return {};
+	}
+
+	/// @brief Get path in the scene
+	/// @param agentSize Width of the agent, paths keep that much room from obstacles (0 for the smallest size)
+	std::vector<std::shared_ptr<Vector2>> GetPath(const Vector2& start, const Vector2& end, float agentSize = 0.0f);
+
+	/// @brief Get path in the scene into a buffer the caller keeps between frames
+	/// @param path Cleared, then filled with the path; its capacity is reused
+	/// @return False when there is no path
+	bool GetPath(const Vector2& start, const Vector2& end, std::vector<Vector2>& path, float agentSize = 0.0f);
+
+	/// @brief Get a path from start to end with an agent's own incremental planner
+	/// @details The planner is created on first use and repairs its previous search on later calls
+	std::vector<std::shared_ptr<Vector2>> GetPath(const Vector2& start, const Vector2& end, std::shared_ptr<DStarLite>& planner, float agentSize = 0.0f);
+
+	/// @brief Get a path with an agent's own incremental planner into a buffer the caller keeps between frames
+	/// @param path Cleared, then filled with the path; its capacity is reused
+	/// @return False when there is no path
+	bool GetPath(const Vector2& start, const Vector2& end, std::shared_ptr<DStarLite>& planner, std::vector<Vector2>& path, float agentSize = 0.0f);
+
+	/// @brief Queue a path query on the worker threads of the collision map
+	/// @details The callback runs during a later AISystem update with the finished path
+	/// @return Handle of the request, 0 when it could not be queued
+	unsigned RequestPath(const Vector2& start, const Vector2& end, float agentSize, std::function<void(std::vector<std::shared_ptr<Vector2>>)> callback);
+
+	/// @brief Queue a path query whose result is handed to the callback by value
+	/// @details The path lives in a buffer the collision map reuses, copy it before the callback returns
+	/// @return Handle of the request, 0 when it could not be queued
+	unsigned RequestPathInto(const Vector2& start, const Vector2& end, float agentSize, std::function<void(const std::vector<Vector2>&)> callback);
+
+	/// @brief Whether a queued path query will still call back
+	/// @details False once its callback ran, or when it was cancelled or dropped with the collision map it was queued on
+	bool IsPathRequestPending(unsigned request);
+
+	/// @brief Get the flow field direction towards a goal
+	/// @details All agents of one size class heading for the same goal tile share one flow field
+	/// @param agentSize Width of the agent, agents of different sizes follow different fields
+	/// @return False when no direction is available at this position
+	bool GetFlowDirection(const Vector2& position, const Vector2& goal, Vector2& direction, float agentSize = 0.0f);
+
+	/// @brief Get the collision map registered with the AISystem
+	/// @details Sized, incremental, queued and flow field queries need it; null when none is registered
+	std::shared_ptr<CollisionMap> GetCollisionMap();
 };
\ No newline at end of file
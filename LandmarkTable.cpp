@@ -0,0 +1,105 @@
+#include "../Headers/LandmarkTable.h"
+#include "../Headers/Pathfinder.h"
+#include <algorithm>
+#include <climits>
+
+LandmarkTable::LandmarkTable(const std::shared_ptr<const NavGrid>& grid, int entitySize, int maxLandmarks, size_t maxBytes,
+    const std::atomic<bool>* cancel)
+{
+    if (!grid || grid->empty())
+        return;
+
+    gridSerial = grid->getSerial();
+    this->entitySize = entitySize;
+
+    const int width = grid->getWidth();
+    const int height = grid->getHeight();
+    const size_t tiles = static_cast<size_t>(width) * height;
+    const size_t perLandmark = tiles * 2 * sizeof(int);
+    const int count = static_cast<int>((std::min)(static_cast<size_t>((std::max)(maxLandmarks, 0)), maxBytes / perLandmark));
+    if (count == 0)
+        return;
+
+    // Seed the farthest-point selection from the walkable tile nearest the centre
+    int seed = -1;
+    long long seedDistance = LLONG_MAX;
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            if (!grid->isWalkable(x, y, entitySize))
+                continue;
+            long long dx = 2 * x - width;
+            long long dy = 2 * y - height;
+            if (dx * dx + dy * dy < seedDistance) {
+                seedDistance = dx * dx + dy * dy;
+                seed = grid->index(x, y);
+            }
+        }
+    }
+    if (seed < 0)
+        return;
+
+    Pathfinder pathfinder(grid, entitySize);
+    SearchContext context(entitySize);
+    const Pathfinder::Region region = pathfinder.fullRegion();
+    auto cancelled = [cancel] { return cancel && cancel->load(std::memory_order_relaxed); };
+
+    // Cost from the nearest landmark so far, the next landmark is where it peaks
+    std::vector<int> nearest(tiles, INT_MAX);
+    pathfinder.floodRegion(context, seed % width, seed / width, region, false, cancel);
+    if (cancelled())
+        return;
+    for (size_t i = 0; i < tiles; ++i)
+        nearest[i] = pathfinder.costTo(context, static_cast<int>(i % width), static_cast<int>(i / width));
+
+    stride = count * 2;
+    costs.assign(tiles * stride, -1);
+
+    for (int k = 0; k < count; ++k) {
+        int farthest = -1;
+        for (size_t i = 0; i < tiles; ++i) {
+            if (nearest[i] > 0 && (farthest < 0 || nearest[i] > nearest[farthest]))
+                farthest = static_cast<int>(i);
+        }
+        if (farthest < 0 || cancelled())
+            break;
+        landmarks.push_back(farthest);
+
+        for (int direction = 0; direction < 2; ++direction) {
+            // Forward from the landmark, then reverse: the cost of reaching it
+            pathfinder.floodRegion(context, farthest % width, farthest / width, region, direction == 1, cancel);
+            if (cancelled())
+                break;
+            for (size_t i = 0; i < tiles; ++i) {
+                int cost = pathfinder.costTo(context, static_cast<int>(i % width), static_cast<int>(i / width));
+                costs[i * stride + k * 2 + direction] = cost;
+                if (direction == 0 && cost >= 0 && cost < nearest[i])
+                    nearest[i] = cost;
+            }
+        }
+    }
+
+    if (cancelled())
+        landmarks.clear();
+
+    // Fewer landmarks than asked for: the map ran out of distinct far tiles
+    if (landmarks.empty()) {
+        costs.clear();
+        stride = 0;
+        return;
+    }
+    if (static_cast<int>(landmarks.size()) < count) {
+        const int used = static_cast<int>(landmarks.size()) * 2;
+        std::vector<int> packed(tiles * used);
+        for (size_t i = 0; i < tiles; ++i)
+            std::copy_n(&costs[i * stride], used, &packed[i * used]);
+        costs = std::move(packed);
+        stride = used;
+    }
+}
+
+LandmarkTable::LandmarkTable(const NavGrid& grid, int entitySize, const std::vector<int>& landmarks, const int* costs)
+    : gridSerial(grid.getSerial()), entitySize(entitySize), landmarks(landmarks)
+{
+    stride = static_cast<int>(landmarks.size()) * 2;
+    this->costs.assign(costs, costs + static_cast<size_t>(grid.getWidth()) * grid.getHeight() * stride);
+}
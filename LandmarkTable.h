@@ -0,0 +1,59 @@
+#pragma once
+#include "NavGrid.h"
+#include <vector>
+#include <memory>
+#include <atomic>
+
+// Path costs from and to a few landmark tiles, for the ALT heuristic. For any
+// landmark L the triangle inequality gives
+//     cost(v, t) >= cost(L, t) - cost(L, v)   and   cost(v, t) >= cost(v, L) - cost(t, L),
+// and on maps where walls force long detours the best of these bounds is far
+// closer to the real cost than the octile distance. A table belongs to one grid
+// and entity size and is never changed once built, so it is shared like the grid.
+class LandmarkTable {
+private:
+    unsigned gridSerial = 0;
+    int entitySize = 1;
+    std::vector<int> landmarks;
+    // Per tile, per landmark: cost from the landmark, then cost to it; -1 where
+    // there is no route. Interleaved so a lookup reads one run of memory per tile.
+    std::vector<int> costs;
+    int stride = 0;
+
+public:
+    // Landmarks are picked far apart: each one is the tile farthest from those
+    // before it. As many are built as fit in maxBytes, up to maxLandmarks.
+    // Building stops early and leaves the table empty once cancel is set.
+    LandmarkTable(const std::shared_ptr<const NavGrid>& grid, int entitySize, int maxLandmarks, size_t maxBytes,
+        const std::atomic<bool>* cancel = nullptr);
+    // Table read back from baked data for a grid of the same map: per tile, per
+    // landmark, the cost from it and the cost to it, as getCosts lays them out
+    LandmarkTable(const NavGrid& grid, int entitySize, const std::vector<int>& landmarks, const int* costs);
+    ~LandmarkTable() = default;
+
+    // True when the table holds bounds for searches of this grid and entity size
+    bool covers(const NavGrid& grid, int entitySize) const
+    {
+        return !landmarks.empty() && grid.getSerial() == gridSerial && entitySize == this->entitySize;
+    }
+
+    // Lower bound on the cost of moving from one tile to another (tile indices)
+    int lowerBound(int from, int to) const
+    {
+        const int* a = &costs[static_cast<size_t>(from) * stride];
+        const int* b = &costs[static_cast<size_t>(to) * stride];
+        int best = 0;
+        for (int k = 0; k < stride; k += 2) {
+            if (a[k] >= 0 && b[k] >= 0 && b[k] - a[k] > best)
+                best = b[k] - a[k];
+            if (a[k + 1] >= 0 && b[k + 1] >= 0 && a[k + 1] - b[k + 1] > best)
+                best = a[k + 1] - b[k + 1];
+        }
+        return best;
+    }
+
+    int getEntitySize() const { return entitySize; }
+    const std::vector<int>& getLandmarks() const { return landmarks; }
+    const std::vector<int>& getCosts() const { return costs; }
+    size_t getMemoryUsage() const { return costs.size() * sizeof(int); }
+};
@@ -0,0 +1,328 @@
+#include "../Headers/NavAsset.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    const char assetMagic[4] = { 'N', 'A', 'V', 'B' };
+    const size_t sectionAlignment = 8;
+
+    size_t alignUp(size_t offset)
+    {
+        return (offset + sectionAlignment - 1) & ~(sectionAlignment - 1);
+    }
+}
+
+uint64_t NavAsset::hash(const void* bytes, size_t length, uint64_t seed)
+{
+    const unsigned char* from = static_cast<const unsigned char*>(bytes);
+    uint64_t value = seed;
+    size_t at = 0;
+    for (; at + 8 <= length; at += 8) {
+        uint64_t word;
+        std::memcpy(&word, from + at, 8);
+        value = (value ^ word) * 1099511628211ull;
+    }
+    for (; at < length; ++at)
+        value = (value ^ from[at]) * 1099511628211ull;
+    return value;
+}
+
+bool NavAsset::write(const std::string& path, const Contents& contents)
+{
+    struct Part {
+        Section id;
+        uint32_t elementSize;
+        const void* data;
+        size_t count;
+    };
+    std::vector<Part> parts;
+    auto add = [&parts](Section id, uint32_t elementSize, const void* data, size_t count) {
+        parts.push_back({ id, elementSize, data, count });
+    };
+
+    if (contents.occupancy)
+        add(Section::Occupancy, sizeof(uint64_t), contents.occupancy->getWords().data(), contents.occupancy->getWords().size());
+    if (contents.grid) {
+        add(Section::Clearance, 1, contents.grid->getClearance().data(), contents.grid->getClearance().size());
+        const std::vector<int>& jumpTable = contents.grid->getJumpTable(1);
+        add(Section::JumpTable, sizeof(int), jumpTable.data(), jumpTable.size());
+    }
+    if (contents.staticOccupancy)
+        add(Section::StaticOccupancy, sizeof(uint64_t), contents.staticOccupancy->getWords().data(), contents.staticOccupancy->getWords().size());
+    if (contents.staticGrid)
+        add(Section::StaticClearance, 1, contents.staticGrid->getClearance().data(), contents.staticGrid->getClearance().size());
+
+    std::vector<int> landmarks;
+    if (contents.landmarks) {
+        const std::vector<int>& tiles = contents.landmarks->getLandmarks();
+        const std::vector<int>& costs = contents.landmarks->getCosts();
+        landmarks = { contents.landmarks->getEntitySize(), static_cast<int>(tiles.size()) };
+        landmarks.insert(landmarks.end(), tiles.begin(), tiles.end());
+        landmarks.insert(landmarks.end(), costs.begin(), costs.end());
+        add(Section::Landmarks, sizeof(int), landmarks.data(), landmarks.size());
+    }
+
+    std::vector<int> components;
+    if (contents.components) {
+        const std::vector<int>& labels = contents.components->getLabels();
+        components = { contents.components->getEntitySize(), contents.components->getComponentCount() };
+        components.insert(components.end(), labels.begin(), labels.end());
+        add(Section::Components, sizeof(int), components.data(), components.size());
+    }
+
+    std::vector<int> hierarchy;
+    if (contents.hierarchy) {
+        std::vector<int> nodeData;
+        std::vector<int> edgeData;
+        contents.hierarchy->saveGraph(nodeData, edgeData);
+        hierarchy = { contents.hierarchy->getClusterSize(), contents.hierarchy->getEntitySize(),
+            static_cast<int>(nodeData.size() / 3), static_cast<int>(edgeData.size() / 2) };
+        hierarchy.insert(hierarchy.end(), nodeData.begin(), nodeData.end());
+        hierarchy.insert(hierarchy.end(), edgeData.begin(), edgeData.end());
+        add(Section::Hierarchy, sizeof(int), hierarchy.data(), hierarchy.size());
+    }
+
+    // Lay the sections out after the header and table, which end on a whole word themselves
+    static_assert(sizeof(Header) % sectionAlignment == 0 && sizeof(SectionEntry) % sectionAlignment == 0,
+        "sections start right after the table");
+    Header header = {};
+    std::memcpy(header.magic, assetMagic, sizeof(assetMagic));
+    header.version = formatVersion;
+    header.headerSize = sizeof(Header);
+    header.sectionCount = static_cast<uint32_t>(parts.size());
+    header.layout = contents.layout;
+
+    std::vector<SectionEntry> table(parts.size());
+    size_t offset = alignUp(sizeof(Header) + table.size() * sizeof(SectionEntry));
+    for (size_t s = 0; s < parts.size(); ++s) {
+        table[s] = { static_cast<uint32_t>(parts[s].id), parts[s].elementSize, offset, parts[s].count };
+        offset = alignUp(offset + parts[s].count * parts[s].elementSize);
+    }
+
+    // The checksum runs over the table and every section with its padding, as open reads
+    // them in one piece: each run ends on a whole word, so the hash goes word by word alike
+    uint64_t checksum = hash(table.data(), table.size() * sizeof(SectionEntry));
+    for (const Part& part : parts) {
+        const size_t bytes = part.count * part.elementSize;
+        const size_t whole = bytes & ~(sectionAlignment - 1);
+        checksum = hash(part.data, whole, checksum);
+        if (whole < bytes) {
+            unsigned char last[sectionAlignment] = {};
+            std::memcpy(last, static_cast<const unsigned char*>(part.data) + whole, bytes - whole);
+            checksum = hash(last, sectionAlignment, checksum);
+        }
+    }
+    header.checksum = checksum;
+
+    const char padding[sectionAlignment] = {};
+    const size_t tableEnd = sizeof(Header) + table.size() * sizeof(SectionEntry);
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file)
+        return false;
+    file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+    file.write(reinterpret_cast<const char*>(table.data()), table.size() * sizeof(SectionEntry));
+    file.write(padding, alignUp(tableEnd) - tableEnd);
+    for (const Part& part : parts) {
+        const size_t bytes = part.count * part.elementSize;
+        file.write(static_cast<const char*>(part.data), bytes);
+        file.write(padding, alignUp(bytes) - bytes);
+    }
+    file.close();
+    return !file.fail();
+}
+
+bool NavAsset::open(const std::string& path)
+{
+    close();
+
+#if defined(_WIN32)
+    HANDLE fileHandle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (fileHandle == INVALID_HANDLE_VALUE)
+        return false;
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart < static_cast<LONGLONG>(sizeof(Header))) {
+        CloseHandle(fileHandle);
+        return false;
+    }
+    HANDLE mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    const void* view = mappingHandle ? MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!view) {
+        if (mappingHandle)
+            CloseHandle(mappingHandle);
+        CloseHandle(fileHandle);
+        return false;
+    }
+    file = fileHandle;
+    mapping = mappingHandle;
+    data = static_cast<const unsigned char*>(view);
+    size = static_cast<size_t>(fileSize.QuadPart);
+#else
+    const int descriptor = ::open(path.c_str(), O_RDONLY);
+    if (descriptor < 0)
+        return false;
+    struct stat status;
+    if (fstat(descriptor, &status) != 0 || status.st_size < static_cast<off_t>(sizeof(Header))) {
+        ::close(descriptor);
+        return false;
+    }
+    void* view = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, descriptor, 0);
+    ::close(descriptor); // the mapping keeps the file
+    if (view == MAP_FAILED)
+        return false;
+    data = static_cast<const unsigned char*>(view);
+    size = static_cast<size_t>(status.st_size);
+#endif
+
+    // Everything past the header must be where the table says and match the checksum
+    const Header& head = header();
+    bool valid = std::memcmp(head.magic, assetMagic, sizeof(assetMagic)) == 0 &&
+        head.version == formatVersion && head.headerSize == sizeof(Header) &&
+        head.sectionCount <= (size - sizeof(Header)) / sizeof(SectionEntry);
+    if (valid) {
+        const SectionEntry* table = reinterpret_cast<const SectionEntry*>(data + sizeof(Header));
+        const size_t tableEnd = sizeof(Header) + head.sectionCount * sizeof(SectionEntry);
+        for (uint32_t s = 0; valid && s < head.sectionCount; ++s) {
+            const SectionEntry& entry = table[s];
+            valid = entry.offset % sectionAlignment == 0 && entry.offset >= tableEnd && entry.offset <= size &&
+                entry.elementSize > 0 && entry.count <= (size - entry.offset) / entry.elementSize;
+        }
+        valid = valid && hash(data + sizeof(Header), size - sizeof(Header)) == head.checksum;
+    }
+    if (!valid)
+        close();
+    return valid;
+}
+
+void NavAsset::close()
+{
+    if (!data)
+        return;
+#if defined(_WIN32)
+    UnmapViewOfFile(data);
+    CloseHandle(static_cast<HANDLE>(mapping));
+    CloseHandle(static_cast<HANDLE>(file));
+    file = nullptr;
+    mapping = nullptr;
+#else
+    munmap(const_cast<unsigned char*>(data), size);
+#endif
+    data = nullptr;
+    size = 0;
+}
+
+const void* NavAsset::find(Section section, size_t elementSize, size_t& count) const
+{
+    count = 0;
+    if (!data)
+        return nullptr;
+    const SectionEntry* table = reinterpret_cast<const SectionEntry*>(data + sizeof(Header));
+    for (uint32_t s = 0; s < header().sectionCount; ++s) {
+        if (table[s].id != static_cast<uint32_t>(section))
+            continue;
+        if (table[s].elementSize != elementSize)
+            return nullptr;
+        count = static_cast<size_t>(table[s].count);
+        return data + table[s].offset;
+    }
+    return nullptr;
+}
+
+bool NavAsset::readOccupancy(OccupancyGrid& occupancy) const
+{
+    const Layout& layout = getLayout();
+    size_t count;
+    const uint64_t* words = find<uint64_t>(Section::Occupancy, count);
+    if (!words || count != OccupancyGrid(layout.tilesX, layout.tilesY).getWords().size())
+        return false;
+    occupancy = OccupancyGrid(layout.tilesX, layout.tilesY, words);
+    return true;
+}
+
+std::shared_ptr<const NavGrid> NavAsset::readGrid() const
+{
+    const Layout& layout = getLayout();
+    const size_t tiles = static_cast<size_t>(layout.tilesX) * layout.tilesY;
+    size_t count;
+    const unsigned char* clearance = find<unsigned char>(Section::Clearance, count);
+    if (!clearance || count != tiles || tiles == 0)
+        return nullptr;
+    size_t jumpCount;
+    const int* jumpTable = find<int>(Section::JumpTable, jumpCount);
+    return std::make_shared<const NavGrid>(layout.tilesX, layout.tilesY, clearance,
+        jumpCount == tiles * 4 ? jumpTable : nullptr);
+}
+
+bool NavAsset::readStaticOccupancy(OccupancyGrid& occupancy) const
+{
+    const Layout& layout = getLayout();
+    size_t count;
+    const uint64_t* words = find<uint64_t>(Section::StaticOccupancy, count);
+    if (!words || count != OccupancyGrid(layout.tilesX, layout.tilesY).getWords().size())
+        return false;
+    occupancy = OccupancyGrid(layout.tilesX, layout.tilesY, words);
+    return true;
+}
+
+std::shared_ptr<const NavGrid> NavAsset::readStaticGrid() const
+{
+    const Layout& layout = getLayout();
+    const size_t tiles = static_cast<size_t>(layout.tilesX) * layout.tilesY;
+    size_t count;
+    const unsigned char* clearance = find<unsigned char>(Section::StaticClearance, count);
+    if (!clearance || count != tiles || tiles == 0)
+        return nullptr;
+    return std::make_shared<const NavGrid>(layout.tilesX, layout.tilesY, clearance, nullptr);
+}
+
+std::shared_ptr<const LandmarkTable> NavAsset::readLandmarks(const NavGrid& grid) const
+{
+    const size_t tiles = static_cast<size_t>(grid.getWidth()) * grid.getHeight();
+    size_t count;
+    const int* values = find<int>(Section::Landmarks, count);
+    if (!values || count < 2 || values[1] <= 0)
+        return nullptr;
+    const size_t landmarkCount = static_cast<size_t>(values[1]);
+    if (count != 2 + landmarkCount + tiles * landmarkCount * 2)
+        return nullptr;
+    const std::vector<int> landmarks(values + 2, values + 2 + landmarkCount);
+    return std::make_shared<const LandmarkTable>(grid, values[0], landmarks, values + 2 + landmarkCount);
+}
+
+std::shared_ptr<const ComponentLabels> NavAsset::readComponents(const NavGrid& grid) const
+{
+    const size_t tiles = static_cast<size_t>(grid.getWidth()) * grid.getHeight();
+    size_t count;
+    const int* values = find<int>(Section::Components, count);
+    if (!values || count != 2 + tiles)
+        return nullptr;
+    return std::make_shared<const ComponentLabels>(grid, values[0], values[1], values + 2);
+}
+
+bool NavAsset::readHierarchy(HierarchicalMap& hierarchy) const
+{
+    size_t count;
+    const int* values = find<int>(Section::Hierarchy, count);
+    if (!values || count < 4 || values[0] != hierarchy.getClusterSize() || values[2] < 0 || values[3] < 0)
+        return false;
+    const size_t nodeCount = static_cast<size_t>(values[2]);
+    const size_t edgeCount = static_cast<size_t>(values[3]);
+    if (count != 4 + nodeCount * 3 + edgeCount * 2)
+        return false;
+    // A graph baked for another entity size would send refinement through tiles it cannot enter
+    return hierarchy.loadGraph(values + 4, values[2], values + 4 + nodeCount * 3, values[3]) &&
+        hierarchy.getEntitySize() == values[1];
+}
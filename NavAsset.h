@@ -0,0 +1,129 @@
+#pragma once
+#include "OccupancyGrid.h"
+#include "NavGrid.h"
+#include "LandmarkTable.h"
+#include "ComponentLabels.h"
+#include "HierarchicalMap.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+// Navigation data baked offline into one binary file, so that startup reads it
+// back instead of computing it: the occupancy, clearance and jump table of the
+// map, the static layer if there is one, landmarks, region labels and the
+// cluster hierarchy. The file is a header, a table of sections and the
+// sections, each 8-byte aligned. Opening maps the file into memory and checks
+// its magic, version and a checksum over everything past the header; the
+// structures are then filled by copying straight out of the mapping. They are
+// not views into it: the map edits its grids in place as colliders move, and
+// the asset can be closed once loaded. The checksum has read every page by
+// then, so a copy costs one memcpy per section. Files are read on the machine
+// kind that wrote them, the byte order is not converted.
+class NavAsset {
+public:
+    static constexpr uint32_t formatVersion = 1;
+
+    // Where the map lies in the world and what it was baked from
+    struct Layout {
+        uint64_t sceneHash = 0; // of the collider footprints, see hash
+        float worldStartX = 0.0f;
+        float worldStartY = 0.0f;
+        float worldEndX = 0.0f;
+        float worldEndY = 0.0f;
+        float smallestEntitySize = 0.0f;
+        float accuracy = 0.0f;
+        int32_t worldWidth = 0;
+        int32_t worldHeight = 0;
+        int32_t tilesX = 0;
+        int32_t tilesY = 0;
+    };
+
+    // What a bake writes; null parts are left out of the file
+    struct Contents {
+        Layout layout;
+        const OccupancyGrid* occupancy = nullptr;
+        const NavGrid* grid = nullptr;
+        const OccupancyGrid* staticOccupancy = nullptr;
+        const NavGrid* staticGrid = nullptr;
+        const LandmarkTable* landmarks = nullptr;
+        const ComponentLabels* components = nullptr;
+        const HierarchicalMap* hierarchy = nullptr;
+    };
+
+private:
+    enum class Section : uint32_t {
+        Occupancy = 1,
+        Clearance,
+        JumpTable,
+        StaticOccupancy,
+        StaticClearance,
+        Landmarks,
+        Components,
+        Hierarchy,
+    };
+
+    struct Header {
+        char magic[4];
+        uint32_t version;
+        uint32_t headerSize; // guards against a compiler laying the structs out differently
+        uint32_t sectionCount;
+        uint64_t checksum; // of the section table and every section
+        Layout layout;
+    };
+
+    struct SectionEntry {
+        uint32_t id;
+        uint32_t elementSize;
+        uint64_t offset; // from the start of the file
+        uint64_t count;
+    };
+
+    const unsigned char* data = nullptr;
+    size_t size = 0;
+#if defined(_WIN32)
+    void* file = nullptr;
+    void* mapping = nullptr;
+#endif
+
+    const Header& header() const { return *reinterpret_cast<const Header*>(data); }
+    // Elements of a section, null when the file has none of the right element size
+    const void* find(Section section, size_t elementSize, size_t& count) const;
+    template <class T> const T* find(Section section, size_t& count) const
+    {
+        return static_cast<const T*>(find(section, sizeof(T), count));
+    }
+
+public:
+    NavAsset() = default;
+    ~NavAsset() { close(); }
+
+    NavAsset(const NavAsset&) = delete;
+    NavAsset& operator=(const NavAsset&) = delete;
+
+    // False when the file could not be written
+    static bool write(const std::string& path, const Contents& contents);
+
+    // Maps the file; false, with nothing open, when it is missing, from another
+    // format version or damaged
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return data != nullptr; }
+
+    const Layout& getLayout() const { return header().layout; }
+
+    // Each part read back; false or null when the file holds none that fits the layout
+    bool readOccupancy(OccupancyGrid& occupancy) const;
+    std::shared_ptr<const NavGrid> readGrid() const;
+    bool readStaticOccupancy(OccupancyGrid& occupancy) const;
+    std::shared_ptr<const NavGrid> readStaticGrid() const;
+    // Landmarks and labels are attached to the grid they were baked for
+    std::shared_ptr<const LandmarkTable> readLandmarks(const NavGrid& grid) const;
+    std::shared_ptr<const ComponentLabels> readComponents(const NavGrid& grid) const;
+    // The hierarchy's pathfinder must already search the grid it was baked for
+    bool readHierarchy(HierarchicalMap& hierarchy) const;
+
+    // FNV-1a over 64-bit words, continuing from seed: catches damaged or
+    // truncated files and changed scenes, it is not a cryptographic hash
+    static uint64_t hash(const void* bytes, size_t length, uint64_t seed = 14695981039346656037ull);
+};
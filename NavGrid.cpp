@@ -0,0 +1,270 @@
+#include "../Headers/NavGrid.h"
+#include <algorithm>
+#include <atomic>
+
+namespace {
+    std::atomic<unsigned> nextSerial{ 1 };
+}
+
+NavGrid::NavGrid()
+{
+    serial = nextSerial++;
+}
+
+NavGrid::NavGrid(const OccupancyGrid& occupancy, std::vector<int> weights)
+{
+    serial = nextSerial++;
+    if (occupancy.empty())
+        return;
+
+    width = occupancy.getWidth();
+    height = occupancy.getHeight();
+    this->weights = std::move(weights);
+
+    // Raw tile flags first (1 = free), grown into clearance below
+    clearance.assign(static_cast<size_t>(width) * height, 0);
+    for (int y = 0; y < height; ++y)
+        for (int x = 0; x < width; ++x)
+            clearance[index(x, y)] = occupancy.isBlocked(x, y) ? 0 : 1;
+    buildClearance();
+
+    jumpTables.resize(maxEntitySize + 1);
+    blockedRows.resize(maxEntitySize + 1);
+    blockedColumns.resize(maxEntitySize + 1);
+}
+
+NavGrid::NavGrid(int width, int height, const unsigned char* clearance, const int* jumpTable)
+{
+    serial = nextSerial++;
+    jumpTables.resize(maxEntitySize + 1);
+    blockedRows.resize(maxEntitySize + 1);
+    blockedColumns.resize(maxEntitySize + 1);
+    if (width <= 0 || height <= 0)
+        return;
+
+    this->width = width;
+    this->height = height;
+    const size_t tiles = static_cast<size_t>(width) * height;
+    this->clearance.assign(clearance, clearance + tiles);
+
+    if (jumpTable) {
+        std::call_once(jumpTableBuilt[1], [this, jumpTable, tiles] {
+            jumpTables[1].assign(jumpTable, jumpTable + tiles * 4);
+            jumpTableReady[1].store(true, std::memory_order_release);
+        });
+    }
+}
+
+NavGrid::NavGrid(const NavGrid& previous, const OccupancyGrid& occupancy, const std::vector<int>& changedTiles)
+    : width(previous.width), height(previous.height), clearance(previous.clearance), weights(previous.weights)
+{
+    serial = nextSerial++;
+    jumpTables.resize(maxEntitySize + 1);
+    blockedRows.resize(maxEntitySize + 1);
+    blockedColumns.resize(maxEntitySize + 1);
+
+    int minX = width;
+    int minY = height;
+    int maxX = -1;
+    int maxY = -1;
+    for (int i : changedTiles) {
+        const int x = i % width;
+        const int y = i / width;
+        clearance[i] = occupancy.isBlocked(x, y) ? 0 : 1;
+        minX = (std::min)(minX, x);
+        minY = (std::min)(minY, y);
+        maxX = (std::max)(maxX, x);
+        maxY = (std::max)(maxY, y);
+    }
+    if (maxX < 0)
+        return;
+
+    // Squares only reach right and down, so a change is seen by the tiles above
+    // and left of it, no further than the largest clearance there is
+    minX = (std::max)(0, minX - (maxEntitySize - 1));
+    minY = (std::max)(0, minY - (maxEntitySize - 1));
+    buildClearance(minX, minY, maxX, maxY);
+
+    std::vector<int> changedClearance;
+    for (int y = minY; y <= maxY; ++y) {
+        for (int x = minX; x <= maxX; ++x) {
+            if (clearance[index(x, y)] != previous.clearance[index(x, y)])
+                changedClearance.push_back(index(x, y));
+        }
+    }
+    repairTables(previous, changedClearance);
+}
+
+// Copies every table the previous grid had built and redoes the parts that the
+// tiles whose clearance changed can reach. A tile that turns walkable or
+// blocked for an entity size changes the jump distances along its own row and
+// column and, through forced neighbours, the rows and columns beside them.
+void NavGrid::repairTables(const NavGrid& previous, const std::vector<int>& changedClearance)
+{
+    std::vector<char> rows;
+    std::vector<char> columns;
+    for (int size = 1; size <= maxEntitySize; ++size) {
+        const bool jumps = previous.jumpTableReady[size].load(std::memory_order_acquire);
+        const bool blocked = previous.blockedGridsReady[size].load(std::memory_order_acquire);
+        if (!jumps && !blocked)
+            continue;
+
+        rows.assign(height, 0);
+        columns.assign(width, 0);
+        for (int i : changedClearance) {
+            if ((clearance[i] >= size) == (previous.clearance[i] >= size))
+                continue;
+            const int x = i % width;
+            const int y = i / width;
+            for (int line = (std::max)(0, y - 1); line <= (std::min)(height - 1, y + 1); ++line)
+                rows[line] = 1;
+            for (int line = (std::max)(0, x - 1); line <= (std::min)(width - 1, x + 1); ++line)
+                columns[line] = 1;
+        }
+
+        if (jumps) {
+            std::call_once(jumpTableBuilt[size], [&] {
+                jumpTables[size] = previous.jumpTables[size];
+                for (int y = 0; y < height; ++y) {
+                    if (!rows[y])
+                        continue;
+                    buildJumpLine(jumpTables[size], size, 0, y);
+                    buildJumpLine(jumpTables[size], size, 1, y);
+                }
+                for (int x = 0; x < width; ++x) {
+                    if (!columns[x])
+                        continue;
+                    buildJumpLine(jumpTables[size], size, 2, x);
+                    buildJumpLine(jumpTables[size], size, 3, x);
+                }
+                jumpTableReady[size].store(true, std::memory_order_release);
+            });
+        }
+
+        if (blocked) {
+            std::call_once(blockedGridsBuilt[size], [&] {
+                blockedRows[size] = previous.blockedRows[size];
+                blockedColumns[size] = previous.blockedColumns[size];
+                for (int i : changedClearance) {
+                    const int x = i % width;
+                    const int y = i / width;
+                    blockedRows[size].setBlocked(x, y, clearance[i] < size);
+                    blockedColumns[size].setBlocked(y, x, clearance[i] < size);
+                }
+                blockedGridsReady[size].store(true, std::memory_order_release);
+            });
+        }
+    }
+}
+
+void NavGrid::buildClearance()
+{
+    buildClearance(0, 0, width - 1, height - 1);
+}
+
+// Largest free square per tile, grown from the bottom-right corner: a square of
+// side n fits at a tile when squares of side n - 1 fit at its right, lower and
+// diagonal neighbours. Blocked tiles of the rectangle must hold 0 and those
+// right of or below it must already be final.
+void NavGrid::buildClearance(int minX, int minY, int maxX, int maxY)
+{
+    for (int y = maxY; y >= minY; --y) {
+        for (int x = maxX; x >= minX; --x) {
+            unsigned char& c = clearance[index(x, y)];
+            if (c == 0)
+                continue;
+
+            int right = x + 1 < width ? clearance[index(x + 1, y)] : 0;
+            int down = y + 1 < height ? clearance[index(x, y + 1)] : 0;
+            int diagonal = x + 1 < width && y + 1 < height ? clearance[index(x + 1, y + 1)] : 0;
+            c = static_cast<unsigned char>((std::min)(1 + (std::min)({ right, down, diagonal }), maxEntitySize));
+        }
+    }
+}
+
+const std::vector<int>& NavGrid::getJumpTable(int entitySize) const
+{
+    std::call_once(jumpTableBuilt[entitySize], [this, entitySize] {
+        buildJumpDistances(jumpTables[entitySize], entitySize);
+        jumpTableReady[entitySize].store(true, std::memory_order_release);
+    });
+    return jumpTables[entitySize];
+}
+
+void NavGrid::buildJumpDistances(std::vector<int>& jumpDistances, int entitySize) const
+{
+    jumpDistances.assign(static_cast<size_t>(width) * height * 4, 0);
+
+    for (int dir = 0; dir < 4; ++dir) {
+        const int lines = dir < 2 ? height : width;
+        for (int line = 0; line < lines; ++line)
+            buildJumpLine(jumpDistances, entitySize, dir, line);
+    }
+}
+
+void NavGrid::buildJumpLine(std::vector<int>& jumpDistances, int entitySize, int dir, int line) const
+{
+    static const int dirs[4][2] = { { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 } };
+    const int dx = dirs[dir][0];
+    const int dy = dirs[dir][1];
+
+    // Walk the line against the direction of travel, so the tile ahead
+    // is always resolved before the tile behind it
+    const int length = dx != 0 ? width : height;
+    for (int step = 0; step < length; ++step) {
+        int along = (dx + dy > 0) ? length - 1 - step : step;
+        int x = dx != 0 ? along : line;
+        int y = dx != 0 ? line : along;
+
+        int nx = x + dx;
+        int ny = y + dy;
+        int& distance = jumpDistances[index(x, y) * 4 + dir];
+
+        if (!isWalkable(nx, ny, entitySize))
+            distance = 0;
+        else if (forcedStraight(nx, ny, dx, dy, entitySize))
+            distance = 1;
+        else {
+            int ahead = jumpDistances[index(nx, ny) * 4 + dir];
+            distance = ahead > 0 ? ahead + 1 : ahead - 1;
+        }
+    }
+}
+
+// A tile entered while moving straight is a jump point when a tile beside it
+// can only be reached optimally through it.
+bool NavGrid::forcedStraight(int x, int y, int dx, int dy, int entitySize) const
+{
+    if (dx != 0) {
+        return (isWalkable(x, y - 1, entitySize) && !isWalkable(x - dx, y - 1, entitySize)) ||
+            (isWalkable(x, y + 1, entitySize) && !isWalkable(x - dx, y + 1, entitySize));
+    }
+    return (isWalkable(x - 1, y, entitySize) && !isWalkable(x - 1, y - dy, entitySize)) ||
+        (isWalkable(x + 1, y, entitySize) && !isWalkable(x + 1, y - dy, entitySize));
+}
+
+const OccupancyGrid& NavGrid::getBlockedRows(int entitySize) const
+{
+    getBlockedColumns(entitySize);
+    return blockedRows[entitySize];
+}
+
+const OccupancyGrid& NavGrid::getBlockedColumns(int entitySize) const
+{
+    std::call_once(blockedGridsBuilt[entitySize], [this, entitySize] {
+        OccupancyGrid rows(width, height);
+        OccupancyGrid columns(height, width);
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                if (clearance[index(x, y)] < entitySize) {
+                    rows.setBlocked(x, y, true);
+                    columns.setBlocked(y, x, true);
+                }
+            }
+        }
+        blockedRows[entitySize] = std::move(rows);
+        blockedColumns[entitySize] = std::move(columns);
+        blockedGridsReady[entitySize].store(true, std::memory_order_release);
+    });
+    return blockedColumns[entitySize];
+}
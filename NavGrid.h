@@ -0,0 +1,82 @@
+#pragma once
+#include "OccupancyGrid.h"
+#include <vector>
+#include <mutex>
+#include <atomic>
+
+// Read-only map data shared by every search: the clearance and weight of each
+// tile, plus tables derived from them per entity size on first use. A grid is
+// never changed once built, so any number of threads can search one grid at
+// the same time, each with its own SearchContext.
+class NavGrid {
+public:
+    static constexpr int maxEntitySize = 255;
+
+private:
+    int width = 0;
+    int height = 0;
+    unsigned serial = 0; // unique per grid, tells a context its cached query is from another map
+
+    // Clearance is the side of the largest free square whose top-left tile is
+    // this one (0 on blocked tiles), so an entity of size n fits wherever
+    // clearance >= n.
+    std::vector<unsigned char> clearance;
+    std::vector<int> weights; // empty when every tile costs 1
+
+    // Cardinal jump distances for jump point search, 4 per tile (+x, -x, +y, -y).
+    // > 0: steps to the next jump point, <= 0: minus the free steps before a wall.
+    mutable std::vector<std::vector<int>> jumpTables;
+    // Tiles too narrow for the entity size as bits, for word-wide line of sight
+    // tests: row-major for shallow lines, transposed for steep ones.
+    mutable std::vector<OccupancyGrid> blockedRows;
+    mutable std::vector<OccupancyGrid> blockedColumns;
+    // The derived tables are built once per size, whichever search asks first
+    mutable std::once_flag jumpTableBuilt[maxEntitySize + 1];
+    mutable std::once_flag blockedGridsBuilt[maxEntitySize + 1];
+    // Set once a table is built, so a grid derived from this one can repair it instead
+    mutable std::atomic<bool> jumpTableReady[maxEntitySize + 1] = {};
+    mutable std::atomic<bool> blockedGridsReady[maxEntitySize + 1] = {};
+
+    void buildClearance();
+    void buildClearance(int minX, int minY, int maxX, int maxY);
+    void buildJumpDistances(std::vector<int>& jumpDistances, int entitySize) const;
+    void buildJumpLine(std::vector<int>& jumpDistances, int entitySize, int dir, int line) const;
+    void repairTables(const NavGrid& previous, const std::vector<int>& changedClearance);
+    bool forcedStraight(int x, int y, int dx, int dy, int entitySize) const;
+
+public:
+    NavGrid();
+    // Weights hold one entry per tile (y * width + x), or none when every tile costs 1
+    NavGrid(const OccupancyGrid& occupancy, std::vector<int> weights);
+    // The previous grid with the occupancy of changedTiles (y * width + x) taken
+    // from occupancy. Only clearance that a change can reach is recomputed, and
+    // the tables the previous grid had built are repaired along the lines it touches.
+    NavGrid(const NavGrid& previous, const OccupancyGrid& occupancy, const std::vector<int>& changedTiles);
+    // Grid read back from baked data: the clearance of every tile and, unless
+    // null, the jump table of entity size 1 (see getJumpTable), so neither is computed again
+    NavGrid(int width, int height, const unsigned char* clearance, const int* jumpTable);
+    ~NavGrid() = default;
+
+    NavGrid(const NavGrid&) = delete;
+    NavGrid& operator=(const NavGrid&) = delete;
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    unsigned getSerial() const { return serial; }
+    bool empty() const { return clearance.empty(); }
+
+    int index(int x, int y) const { return y * width + x; }
+    bool inBounds(int x, int y) const { return x >= 0 && x < width && y >= 0 && y < height; }
+    int clearanceAt(int i) const { return clearance[i]; }
+    const std::vector<unsigned char>& getClearance() const { return clearance; }
+    bool isWalkable(int x, int y, int entitySize) const
+    {
+        return inBounds(x, y) && clearance[index(x, y)] >= entitySize;
+    }
+    int weightAt(int i) const { return weights.empty() ? 1 : weights[i]; }
+    bool hasUniformWeights() const { return weights.empty(); }
+
+    const std::vector<int>& getJumpTable(int entitySize) const;
+    const OccupancyGrid& getBlockedRows(int entitySize) const;
+    const OccupancyGrid& getBlockedColumns(int entitySize) const;
+};
@@ -0,0 +1,364 @@
+#include "../Headers/NavMesh.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <functional>
+#include <queue>
+
+namespace {
+    // Twice the signed area of the triangle (apex, a, b): positive when b lies
+    // counterclockwise of a as seen from the apex
+    float cross(const Vector2& apex, const Vector2& a, const Vector2& b)
+    {
+        return (a.getX() - apex.getX()) * (b.getY() - apex.getY()) - (a.getY() - apex.getY()) * (b.getX() - apex.getX());
+    }
+
+    bool samePoint(const Vector2& a, const Vector2& b)
+    {
+        return (a - b).lengthSquared() < 1e-8f;
+    }
+
+    // Point of an edge where the line from a to b crosses it, or the end of the
+    // edge nearest to that crossing. Every edge is horizontal or vertical.
+    Vector2 crossing(const NavMesh::Link& link, const Vector2& a, const Vector2& b)
+    {
+        const bool vertical = link.xA == link.xB;
+        const float edge = vertical ? link.xA : link.yA;
+        const float across = vertical ? b.getX() - a.getX() : b.getY() - a.getY();
+        const float along = vertical ? b.getY() - a.getY() : b.getX() - a.getX();
+        const float origin = vertical ? a.getY() : a.getX();
+        float t = vertical ? (link.yA + link.yB) * 0.5f : (link.xA + link.xB) * 0.5f;
+        if (across != 0.0f)
+            t = origin + along * (edge - (vertical ? a.getX() : a.getY())) / across;
+        const float low = vertical ? (std::min)(link.yA, link.yB) : (std::min)(link.xA, link.xB);
+        const float high = vertical ? (std::max)(link.yA, link.yB) : (std::max)(link.xA, link.xB);
+        t = (std::max)(low, (std::min)(t, high));
+        return vertical ? Vector2(edge, t) : Vector2(t, edge);
+    }
+}
+
+NavMesh::NavMesh(const std::vector<NavObstacle>& obstacles, float minX, float minY, float maxX, float maxY, float agentRadius)
+    : agentRadius(agentRadius)
+{
+    minX += agentRadius;
+    minY += agentRadius;
+    maxX -= agentRadius;
+    maxY -= agentRadius;
+    if (minX >= maxX || minY >= maxY)
+        return;
+
+    std::vector<NavBox> boxes;
+    boxes.reserve(obstacles.size() * 3);
+    for (const NavObstacle& obstacle : obstacles)
+        coverObstacle(obstacle, agentRadius, boxes);
+
+    xs = { minX, maxX };
+    ys = { minY, maxY };
+    for (const NavBox& box : boxes) {
+        for (float x : { box.minX, box.maxX }) {
+            if (x > minX && x < maxX)
+                xs.push_back(x);
+        }
+        for (float y : { box.minY, box.maxY }) {
+            if (y > minY && y < maxY)
+                ys.push_back(y);
+        }
+    }
+    std::sort(xs.begin(), xs.end());
+    xs.erase(std::unique(xs.begin(), xs.end()), xs.end());
+    std::sort(ys.begin(), ys.end());
+    ys.erase(std::unique(ys.begin(), ys.end()), ys.end());
+
+    // Every box edge is a cell boundary, so a box covers a whole range of cells
+    const int columns = static_cast<int>(xs.size()) - 1;
+    const int rows = static_cast<int>(ys.size()) - 1;
+    std::vector<char> blocked(static_cast<size_t>(columns) * rows, 0);
+    for (const NavBox& box : boxes) {
+        const int i0 = static_cast<int>(std::lower_bound(xs.begin(), xs.end(), box.minX) - xs.begin());
+        const int i1 = (std::min)(columns, static_cast<int>(std::lower_bound(xs.begin(), xs.end(), box.maxX) - xs.begin()));
+        const int j0 = static_cast<int>(std::lower_bound(ys.begin(), ys.end(), box.minY) - ys.begin());
+        const int j1 = (std::min)(rows, static_cast<int>(std::lower_bound(ys.begin(), ys.end(), box.maxY) - ys.begin()));
+        for (int j = j0; j < j1; ++j) {
+            for (int i = i0; i < i1; ++i)
+                blocked[static_cast<size_t>(j) * columns + i] = 1;
+        }
+    }
+
+    mergeCells(blocked);
+    linkPolygons();
+}
+
+// Each row's runs of free cells become rectangles, and a run that spans the
+// same columns as one in the row above extends that rectangle downwards
+void NavMesh::mergeCells(const std::vector<char>& blocked)
+{
+    struct Span {
+        int i0;
+        int i1;
+        int polygon;
+    };
+
+    const int columns = static_cast<int>(xs.size()) - 1;
+    const int rows = static_cast<int>(ys.size()) - 1;
+    cellPolygons.assign(blocked.size(), -1);
+
+    std::vector<Span> above;
+    std::vector<Span> current;
+    for (int j = 0; j < rows; ++j) {
+        current.clear();
+        size_t k = 0;
+        for (int i = 0; i < columns;) {
+            if (blocked[static_cast<size_t>(j) * columns + i]) {
+                i++;
+                continue;
+            }
+            const int i0 = i;
+            while (i < columns && !blocked[static_cast<size_t>(j) * columns + i])
+                i++;
+
+            while (k < above.size() && above[k].i0 < i0)
+                k++;
+            int polygon;
+            if (k < above.size() && above[k].i0 == i0 && above[k].i1 == i) {
+                polygon = above[k].polygon;
+                polygons[polygon].maxY = ys[j + 1];
+            }
+            else {
+                polygon = static_cast<int>(polygons.size());
+                polygons.push_back({ xs[i0], ys[j], xs[i], ys[j + 1], 0, 0 });
+            }
+            current.push_back({ i0, i, polygon });
+            for (int c = i0; c < i; ++c)
+                cellPolygons[static_cast<size_t>(j) * columns + c] = polygon;
+        }
+        std::swap(above, current);
+    }
+}
+
+void NavMesh::linkPolygons()
+{
+    const int columns = static_cast<int>(xs.size()) - 1;
+    const int rows = static_cast<int>(ys.size()) - 1;
+    auto indexOf = [](const std::vector<float>& bounds, float v) {
+        return static_cast<int>(std::lower_bound(bounds.begin(), bounds.end(), v) - bounds.begin());
+    };
+
+    for (size_t p = 0; p < polygons.size(); ++p) {
+        Polygon& polygon = polygons[p];
+        polygon.firstLink = static_cast<int>(links.size());
+        const int i0 = indexOf(xs, polygon.minX);
+        const int i1 = indexOf(xs, polygon.maxX);
+        const int j0 = indexOf(ys, polygon.minY);
+        const int j1 = indexOf(ys, polygon.maxY);
+
+        // Runs of one neighbour along a column (vertical edge) or a row of cells
+        auto addRuns = [&](int fixed, int from, int to, bool vertical, float edge) {
+            for (int k = from; k < to;) {
+                const int neighbour = vertical ? cellPolygons[static_cast<size_t>(k) * columns + fixed]
+                                               : cellPolygons[static_cast<size_t>(fixed) * columns + k];
+                const int start = k;
+                do {
+                    k++;
+                } while (k < to && (vertical ? cellPolygons[static_cast<size_t>(k) * columns + fixed]
+                                             : cellPolygons[static_cast<size_t>(fixed) * columns + k]) == neighbour);
+                if (neighbour < 0)
+                    continue;
+                if (vertical)
+                    links.push_back({ neighbour, edge, ys[start], edge, ys[k] });
+                else
+                    links.push_back({ neighbour, xs[start], edge, xs[k], edge });
+            }
+        };
+        if (i0 > 0)
+            addRuns(i0 - 1, j0, j1, true, polygon.minX);
+        if (i1 < columns)
+            addRuns(i1, j0, j1, true, polygon.maxX);
+        if (j0 > 0)
+            addRuns(j0 - 1, i0, i1, false, polygon.minY);
+        if (j1 < rows)
+            addRuns(j1, i0, i1, false, polygon.maxY);
+
+        polygon.linkCount = static_cast<int>(links.size()) - polygon.firstLink;
+    }
+}
+
+int NavMesh::cellAt(float x, float y) const
+{
+    if (xs.size() < 2 || x < xs.front() || x > xs.back() || y < ys.front() || y > ys.back())
+        return -1;
+
+    const int columns = static_cast<int>(xs.size()) - 1;
+    const int rows = static_cast<int>(ys.size()) - 1;
+    const int i = (std::min)(columns - 1, static_cast<int>(std::upper_bound(xs.begin(), xs.end(), x) - xs.begin()) - 1);
+    const int j = (std::min)(rows - 1, static_cast<int>(std::upper_bound(ys.begin(), ys.end(), y) - ys.begin()) - 1);
+    return j * columns + i;
+}
+
+int NavMesh::findPolygon(float x, float y) const
+{
+    const int cell = cellAt(x, y);
+    return cell < 0 ? -1 : cellPolygons[cell];
+}
+
+int NavMesh::findNearestPolygon(const Vector2& point, Vector2& nearest) const
+{
+    int polygon = findPolygon(point.getX(), point.getY());
+    if (polygon >= 0) {
+        nearest = point;
+        return polygon;
+    }
+
+    float best = FLT_MAX;
+    for (size_t p = 0; p < polygons.size(); ++p) {
+        const Polygon& candidate = polygons[p];
+        Vector2 clamped((std::max)(candidate.minX, (std::min)(point.getX(), candidate.maxX)),
+            (std::max)(candidate.minY, (std::min)(point.getY(), candidate.maxY)));
+        const float distance = (clamped - point).lengthSquared();
+        if (distance < best) {
+            best = distance;
+            polygon = static_cast<int>(p);
+            nearest = clamped;
+        }
+    }
+    return polygon;
+}
+
+bool NavMesh::findPath(const Vector2& start, const Vector2& finish, std::vector<Vector2>& path) const
+{
+    path.clear();
+    Vector2 from;
+    Vector2 to;
+    const int startPolygon = findNearestPolygon(start, from);
+    const int finishPolygon = findNearestPolygon(finish, to);
+    if (startPolygon < 0 || finishPolygon < 0)
+        return false;
+
+    std::vector<int> corridor;
+    if (!findCorridor(startPolygon, from, finishPolygon, to, corridor))
+        return false;
+
+    pullString(corridor, from, to, path);
+    return true;
+}
+
+// A* over the polygons, entering each where the straight line on to the finish
+// crosses the edge it is reached through
+bool NavMesh::findCorridor(int startPolygon, const Vector2& start, int finishPolygon, const Vector2& finish,
+    std::vector<int>& corridor) const
+{
+    typedef std::pair<float, int> Entry;
+    const size_t count = polygons.size();
+    std::vector<float> costs(count, FLT_MAX);
+    std::vector<int> parents(count, -1);
+    std::vector<Vector2> entries(count);
+    std::vector<char> closed(count, 0);
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+
+    costs[startPolygon] = 0.0f;
+    entries[startPolygon] = start;
+    open.push({ (finish - start).length(), startPolygon });
+    while (!open.empty()) {
+        const int current = open.top().second;
+        open.pop();
+        if (closed[current])
+            continue;
+        if (current == finishPolygon)
+            break;
+        closed[current] = 1;
+
+        const Polygon& polygon = polygons[current];
+        for (int l = polygon.firstLink; l < polygon.firstLink + polygon.linkCount; ++l) {
+            const Link& link = links[l];
+            if (closed[link.to])
+                continue;
+            const Vector2 entry = crossing(link, entries[current], finish);
+            const float cost = costs[current] + (entry - entries[current]).length();
+            if (cost < costs[link.to]) {
+                costs[link.to] = cost;
+                parents[link.to] = current;
+                entries[link.to] = entry;
+                open.push({ cost + (finish - entry).length(), link.to });
+            }
+        }
+    }
+    if (costs[finishPolygon] == FLT_MAX)
+        return false;
+
+    corridor.clear();
+    for (int p = finishPolygon; p >= 0; p = parents[p])
+        corridor.push_back(p);
+    std::reverse(corridor.begin(), corridor.end());
+    return true;
+}
+
+// Simple stupid funnel algorithm: the funnel from the apex narrows portal by
+// portal, and where one side would cross the other the path turns at its corner
+void NavMesh::pullString(const std::vector<int>& corridor, const Vector2& start, const Vector2& finish,
+    std::vector<Vector2>& path) const
+{
+    // Portal endpoints, left and right as seen walking the corridor
+    std::vector<Vector2> lefts(1, start);
+    std::vector<Vector2> rights(1, start);
+    for (size_t k = 0; k + 1 < corridor.size(); ++k) {
+        const Polygon& from = polygons[corridor[k]];
+        const Polygon& to = polygons[corridor[k + 1]];
+        for (int l = from.firstLink; l < from.firstLink + from.linkCount; ++l) {
+            const Link& link = links[l];
+            if (link.to != corridor[k + 1])
+                continue;
+            const Vector2 a(link.xA, link.yA);
+            const Vector2 b(link.xB, link.yB);
+            const Vector2 centreFrom((from.minX + from.maxX) * 0.5f, (from.minY + from.maxY) * 0.5f);
+            const Vector2 centreTo((to.minX + to.maxX) * 0.5f, (to.minY + to.maxY) * 0.5f);
+            const bool aLeft = cross(centreFrom, centreTo, a) > cross(centreFrom, centreTo, b);
+            lefts.push_back(aLeft ? a : b);
+            rights.push_back(aLeft ? b : a);
+            break;
+        }
+    }
+    lefts.push_back(finish);
+    rights.push_back(finish);
+
+    path.push_back(start);
+    Vector2 apex = start;
+    Vector2 left = start;
+    Vector2 right = start;
+    size_t leftIndex = 0;
+    size_t rightIndex = 0;
+    for (size_t i = 1; i < lefts.size(); ++i) {
+        // A new right side that turns inwards narrows the funnel, unless it crosses the left side
+        if (cross(apex, right, rights[i]) >= 0.0f) {
+            if (samePoint(apex, right) || cross(apex, left, rights[i]) < 0.0f) {
+                right = rights[i];
+                rightIndex = i;
+            }
+            else {
+                if (!samePoint(path.back(), left))
+                    path.push_back(left);
+                apex = left;
+                right = left;
+                rightIndex = leftIndex;
+                i = leftIndex;
+                continue;
+            }
+        }
+
+        if (cross(apex, left, lefts[i]) <= 0.0f) {
+            if (samePoint(apex, left) || cross(apex, right, lefts[i]) > 0.0f) {
+                left = lefts[i];
+                leftIndex = i;
+            }
+            else {
+                if (!samePoint(path.back(), right))
+                    path.push_back(right);
+                apex = right;
+                left = right;
+                leftIndex = rightIndex;
+                i = rightIndex;
+                continue;
+            }
+        }
+    }
+    if (!samePoint(path.back(), finish))
+        path.push_back(finish);
+}
@@ -0,0 +1,70 @@
+#pragma once
+#include "NavObstacle.h"
+#include "Vector2.h"
+#include <vector>
+
+// Navigation mesh over the free space between box and circle obstacles, an
+// alternative to the tile grid for open maps with few obstacles. Obstacles are
+// grown by the agent's radius (see coverObstacle) and the free space is cut
+// into axis-aligned rectangles, which are convex: an agent can walk straight
+// between any two points of one. A query runs A* over the rectangles and pulls
+// the path taut through the shared edges with the funnel algorithm, so the
+// node count follows the number of obstacles, not the area.
+class NavMesh {
+public:
+    struct Polygon {
+        float minX;
+        float minY;
+        float maxX;
+        float maxY;
+        int firstLink;
+        int linkCount;
+    };
+
+    // Edge shared with a neighbouring polygon
+    struct Link {
+        int to;
+        float xA;
+        float yA;
+        float xB;
+        float yB;
+    };
+
+private:
+    float agentRadius = 0.0f;
+
+    // Cell boundaries of every obstacle edge; each cell is wholly free or blocked
+    std::vector<float> xs;
+    std::vector<float> ys;
+    std::vector<int> cellPolygons; // per cell, -1 where blocked
+
+    std::vector<Polygon> polygons;
+    std::vector<Link> links;
+
+    int cellAt(float x, float y) const;
+    void mergeCells(const std::vector<char>& blocked);
+    void linkPolygons();
+    bool findCorridor(int startPolygon, const Vector2& start, int finishPolygon, const Vector2& finish,
+        std::vector<int>& corridor) const;
+    void pullString(const std::vector<int>& corridor, const Vector2& start, const Vector2& finish,
+        std::vector<Vector2>& path) const;
+
+public:
+    // The walkable area is the bounds less the agent's radius on every side
+    NavMesh(const std::vector<NavObstacle>& obstacles, float minX, float minY, float maxX, float maxY, float agentRadius);
+    ~NavMesh() = default;
+
+    // Polygon containing the point, -1 when it is inside an obstacle or off the mesh
+    int findPolygon(float x, float y) const;
+    // Polygon closest to the point, with the point moved onto it; -1 for an empty mesh
+    int findNearestPolygon(const Vector2& point, Vector2& nearest) const;
+
+    // Shortest path through the mesh, ends moved onto it when they lie in an obstacle.
+    // Fills path with the start, every corner the path turns at and the finish;
+    // false, with path empty, when the two are not connected.
+    bool findPath(const Vector2& start, const Vector2& finish, std::vector<Vector2>& path) const;
+
+    float getAgentRadius() const { return agentRadius; }
+    const std::vector<Polygon>& getPolygons() const { return polygons; }
+    const std::vector<Link>& getLinks() const { return links; }
+};
@@ -0,0 +1,49 @@
+#pragma once
+#include <cmath>
+#include <vector>
+
+// Footprint of a box or circle collider in world units, as the navigation
+// structures built straight from the colliders see it
+struct NavObstacle {
+    float x = 0.0f;          // centre
+    float y = 0.0f;
+    float halfWidth = 0.0f;  // extent of a box
+    float halfHeight = 0.0f;
+    float radius = 0.0f;     // radius of a circle, 0 for a box
+
+    bool isCircle() const { return radius > 0.0f; }
+
+    bool operator==(const NavObstacle& other) const
+    {
+        return x == other.x && y == other.y && halfWidth == other.halfWidth &&
+            halfHeight == other.halfHeight && radius == other.radius;
+    }
+    bool operator!=(const NavObstacle& other) const { return !(*this == other); }
+};
+
+// Axis-aligned box in world units
+struct NavBox {
+    float minX;
+    float minY;
+    float maxX;
+    float maxY;
+};
+
+// Boxes covering an obstacle grown by margin on every side. A circle is covered
+// by a box over its middle half and a narrower one above and below, which
+// leaves the corners of its bounding square free.
+inline void coverObstacle(const NavObstacle& obstacle, float margin, std::vector<NavBox>& boxes)
+{
+    if (obstacle.isCircle()) {
+        const float r = obstacle.radius;
+        const float inner = r * 0.5f;
+        const float outer = r * std::sqrt(0.75f);
+        boxes.push_back({ obstacle.x - outer - margin, obstacle.y - r - margin, obstacle.x + outer + margin, obstacle.y - inner + margin });
+        boxes.push_back({ obstacle.x - r - margin, obstacle.y - inner - margin, obstacle.x + r + margin, obstacle.y + inner + margin });
+        boxes.push_back({ obstacle.x - outer - margin, obstacle.y + inner - margin, obstacle.x + outer + margin, obstacle.y + r + margin });
+    }
+    else {
+        boxes.push_back({ obstacle.x - obstacle.halfWidth - margin, obstacle.y - obstacle.halfHeight - margin,
+            obstacle.x + obstacle.halfWidth + margin, obstacle.y + obstacle.halfHeight + margin });
+    }
+}
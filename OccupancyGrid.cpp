@@ -0,0 +1,205 @@
+#include "../Headers/OccupancyGrid.h"
+#include <algorithm>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace {
+    int lowestBit(uint64_t word)
+    {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward64(&index, word);
+        return static_cast<int>(index);
+#else
+        return __builtin_ctzll(word);
+#endif
+    }
+}
+
+OccupancyGrid::OccupancyGrid(int width, int height)
+{
+    if (width <= 0 || height <= 0)
+        return;
+
+    this->width = width;
+    this->height = height;
+    wordsPerRow = (width + 63) / 64;
+    words.assign(static_cast<size_t>(wordsPerRow) * height, 0);
+}
+
+OccupancyGrid::OccupancyGrid(int width, int height, const uint64_t* words)
+    : OccupancyGrid(width, height)
+{
+    if (!this->words.empty())
+        std::copy_n(words, this->words.size(), this->words.begin());
+}
+
+void OccupancyGrid::setBlocked(int x, int y, bool blocked)
+{
+    if (x < 0 || y < 0 || x >= width || y >= height)
+        return;
+
+    uint64_t& word = words[static_cast<size_t>(y) * wordsPerRow + (x >> 6)];
+    const uint64_t bit = 1ull << (x & 63);
+    if (blocked)
+        word |= bit;
+    else
+        word &= ~bit;
+}
+
+void OccupancyGrid::fillRect(int minX, int minY, int maxX, int maxY, bool blocked)
+{
+    minX = (std::max)(minX, 0);
+    minY = (std::max)(minY, 0);
+    maxX = (std::min)(maxX, width - 1);
+    maxY = (std::min)(maxY, height - 1);
+    if (minX > maxX || minY > maxY)
+        return;
+
+    const int firstWord = minX >> 6;
+    const int lastWord = maxX >> 6;
+    auto fill = [blocked](uint64_t& word, uint64_t mask) {
+        word = blocked ? word | mask : word & ~mask;
+    };
+
+    for (int y = minY; y <= maxY; ++y) {
+        uint64_t* row = &words[static_cast<size_t>(y) * wordsPerRow];
+        if (firstWord == lastWord) {
+            fill(row[firstWord], spanMask(minX & 63, maxX & 63));
+            continue;
+        }
+        fill(row[firstWord], spanMask(minX & 63, 63));
+        for (int w = firstWord + 1; w < lastWord; ++w)
+            row[w] = blocked ? ~0ull : 0;
+        fill(row[lastWord], spanMask(0, maxX & 63));
+    }
+}
+
+void OccupancyGrid::copyRect(const OccupancyGrid& source, int minX, int minY, int maxX, int maxY)
+{
+    minX = (std::max)(minX, 0);
+    minY = (std::max)(minY, 0);
+    maxX = (std::min)(maxX, width - 1);
+    maxY = (std::min)(maxY, height - 1);
+    if (minX > maxX || minY > maxY || source.width != width || source.height != height)
+        return;
+
+    const int firstWord = minX >> 6;
+    const int lastWord = maxX >> 6;
+    for (int y = minY; y <= maxY; ++y) {
+        const size_t rowStart = static_cast<size_t>(y) * wordsPerRow;
+        for (int w = firstWord; w <= lastWord; ++w) {
+            const uint64_t mask = spanMask(w == firstWord ? minX & 63 : 0, w == lastWord ? maxX & 63 : 63);
+            words[rowStart + w] = (words[rowStart + w] & ~mask) | (source.words[rowStart + w] & mask);
+        }
+    }
+}
+
+void OccupancyGrid::copyBlock(const OccupancyGrid& source, int sourceX, int sourceY, int x, int y, int blockWidth, int blockHeight)
+{
+    // Clip the block to both grids, moving both corners together
+    const int shiftX = (std::max)({ 0, -x, -sourceX });
+    const int shiftY = (std::max)({ 0, -y, -sourceY });
+    x += shiftX;
+    sourceX += shiftX;
+    y += shiftY;
+    sourceY += shiftY;
+    blockWidth = (std::min)({ blockWidth - shiftX, width - x, source.width - sourceX });
+    blockHeight = (std::min)({ blockHeight - shiftY, height - y, source.height - sourceY });
+    if (blockWidth <= 0 || blockHeight <= 0)
+        return;
+
+    for (int row = 0; row < blockHeight; ++row) {
+        const uint64_t* from = &source.words[static_cast<size_t>(sourceY + row) * source.wordsPerRow];
+        uint64_t* to = &words[static_cast<size_t>(y + row) * wordsPerRow];
+
+        // One destination word at a time, gathering its bits from up to two source words
+        for (int done = 0; done < blockWidth;) {
+            const int toBit = (x + done) & 63;
+            const int count = (std::min)(64 - toBit, blockWidth - done);
+            const int fromX = sourceX + done;
+            const int fromWord = fromX >> 6;
+            const int fromBit = fromX & 63;
+            uint64_t bits = from[fromWord] >> fromBit;
+            if (fromBit != 0 && fromWord + 1 < source.wordsPerRow)
+                bits |= from[fromWord + 1] << (64 - fromBit);
+
+            const uint64_t mask = spanMask(toBit, toBit + count - 1);
+            uint64_t& word = to[(x + done) >> 6];
+            word = (word & ~mask) | ((bits << toBit) & mask);
+            done += count;
+        }
+    }
+}
+
+bool OccupancyGrid::isSpanFree(int y, int minX, int maxX) const
+{
+    if (y < 0 || y >= height || minX < 0 || maxX >= width)
+        return false;
+    if (minX > maxX)
+        return true;
+
+    const uint64_t* row = &words[static_cast<size_t>(y) * wordsPerRow];
+    const int firstWord = minX >> 6;
+    const int lastWord = maxX >> 6;
+
+    if (firstWord == lastWord)
+        return (row[firstWord] & spanMask(minX & 63, maxX & 63)) == 0;
+
+    if (row[firstWord] & spanMask(minX & 63, 63))
+        return false;
+    for (int w = firstWord + 1; w < lastWord; ++w) {
+        if (row[w])
+            return false;
+    }
+    return (row[lastWord] & spanMask(0, maxX & 63)) == 0;
+}
+
+bool OccupancyGrid::isRectFree(int minX, int minY, int maxX, int maxY) const
+{
+    for (int y = minY; y <= maxY; ++y) {
+        if (!isSpanFree(y, minX, maxX))
+            return false;
+    }
+    return true;
+}
+
+bool OccupancyGrid::isRectBlocked(int minX, int minY, int maxX, int maxY) const
+{
+    minX = (std::max)(minX, 0);
+    minY = (std::max)(minY, 0);
+    maxX = (std::min)(maxX, width - 1);
+    maxY = (std::min)(maxY, height - 1);
+
+    const int firstWord = minX >> 6;
+    const int lastWord = maxX >> 6;
+    for (int y = minY; y <= maxY && minX <= maxX; ++y) {
+        const uint64_t* row = &words[static_cast<size_t>(y) * wordsPerRow];
+        for (int w = firstWord; w <= lastWord; ++w) {
+            const uint64_t mask = spanMask(w == firstWord ? minX & 63 : 0, w == lastWord ? maxX & 63 : 63);
+            if ((row[w] & mask) != mask)
+                return false;
+        }
+    }
+    return true;
+}
+
+bool OccupancyGrid::collectChanges(const OccupancyGrid& other, std::vector<int>& changed) const
+{
+    if (width != other.width || height != other.height)
+        return false;
+
+    for (int y = 0; y < height; ++y) {
+        const size_t rowStart = static_cast<size_t>(y) * wordsPerRow;
+        for (int w = 0; w < wordsPerRow; ++w) {
+            uint64_t diff = words[rowStart + w] ^ other.words[rowStart + w];
+            while (diff) {
+                changed.push_back(y * width + w * 64 + lowestBit(diff));
+                diff &= diff - 1;
+            }
+        }
+    }
+    return true;
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// One bit per tile, set when the tile is blocked. Rows are stored as 64-bit
+// words, bit (x % 64) of word (x / 64), so a horizontal span of tiles is tested
+// or filled with one mask per word instead of one lookup per tile.
+// Bits past the map width are always clear.
+class OccupancyGrid {
+private:
+    int width = 0;
+    int height = 0;
+    int wordsPerRow = 0;
+    std::vector<uint64_t> words;
+
+    // Bits from..to (inclusive) of one word
+    static uint64_t spanMask(int from, int to)
+    {
+        return (~0ull >> (63 - to)) & (~0ull << from);
+    }
+
+public:
+    OccupancyGrid() = default;
+    OccupancyGrid(int width, int height);
+    // Grid read back from the words of one saved with getWords
+    OccupancyGrid(int width, int height, const uint64_t* words);
+    ~OccupancyGrid() = default;
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    bool empty() const { return words.empty(); }
+
+    // Tiles outside the map count as blocked
+    bool isBlocked(int x, int y) const
+    {
+        if (x < 0 || y < 0 || x >= width || y >= height)
+            return true;
+        return (words[static_cast<size_t>(y) * wordsPerRow + (x >> 6)] >> (x & 63)) & 1;
+    }
+    void setBlocked(int x, int y, bool blocked);
+
+    // Block (or free) every tile of an inclusive rectangle, clipped to the map
+    void fillRect(int minX, int minY, int maxX, int maxY, bool blocked = true);
+    // Take every tile of an inclusive rectangle, clipped to the map, from a grid of the same size
+    void copyRect(const OccupancyGrid& source, int minX, int minY, int maxX, int maxY);
+    // Take a block of tiles from a grid of any size, its (sourceX, sourceY) landing on (x, y); clipped to both grids
+    void copyBlock(const OccupancyGrid& source, int sourceX, int sourceY, int x, int y, int blockWidth, int blockHeight);
+    // True when no tile of the inclusive span is blocked; spans leaving the map are not free
+    bool isSpanFree(int y, int minX, int maxX) const;
+    bool isRectFree(int minX, int minY, int maxX, int maxY) const;
+    // True when every tile of the inclusive rectangle is blocked; tiles off the map count as blocked
+    bool isRectBlocked(int minX, int minY, int maxX, int maxY) const;
+
+    // Appends the index (y * width + x) of every tile that differs from other.
+    // Returns false when the sizes differ and no tile list can be given.
+    bool collectChanges(const OccupancyGrid& other, std::vector<int>& changed) const;
+
+    const std::vector<uint64_t>& getWords() const { return words; }
+    size_t getMemoryBytes() const { return words.size() * sizeof(uint64_t); }
+    bool operator==(const OccupancyGrid& other) const
+    {
+        return width == other.width && height == other.height && words == other.words;
+    }
+    bool operator!=(const OccupancyGrid& other) const { return !(*this == other); }
+};
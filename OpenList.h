@@ -0,0 +1,131 @@
+#pragma once
+
+#include "SearchNode.h"
+#include <vector>
+
+// Indexed binary min-heap of open A* nodes.
+// Each node stores its own heap slot, so "is open?" is O(1) and a cheaper
+// route found later can be applied with decrease() in O(log n).
+// Ordering: lowest total cost, then lowest finish cost, then the node that
+// was opened first.
+class OpenList {
+private:
+    std::vector<int> heap;
+    int nextOrder = 0;
+
+    static bool before(const SearchNode& a, const SearchNode& b)
+    {
+        if (a.totalCost != b.totalCost)
+            return a.totalCost < b.totalCost;
+        if (a.finishCost != b.finishCost)
+            return a.finishCost < b.finishCost;
+        return a.openOrder < b.openOrder;
+    }
+
+    void place(std::vector<SearchNode>& nodes, int slot, int index)
+    {
+        heap[slot] = index;
+        nodes[index].openIndex = slot;
+    }
+
+    void siftUp(std::vector<SearchNode>& nodes, int slot)
+    {
+        int index = heap[slot];
+        while (slot > 0) {
+            int parent = (slot - 1) / 2;
+            if (!before(nodes[index], nodes[heap[parent]]))
+                break;
+            place(nodes, slot, heap[parent]);
+            slot = parent;
+        }
+        place(nodes, slot, index);
+    }
+
+    void siftDown(std::vector<SearchNode>& nodes, int slot)
+    {
+        int index = heap[slot];
+        int count = static_cast<int>(heap.size());
+        while (true) {
+            int child = slot * 2 + 1;
+            if (child >= count)
+                break;
+            if (child + 1 < count && before(nodes[heap[child + 1]], nodes[heap[child]]))
+                child++;
+            if (!before(nodes[heap[child]], nodes[index]))
+                break;
+            place(nodes, slot, heap[child]);
+            slot = child;
+        }
+        place(nodes, slot, index);
+    }
+
+public:
+    bool empty() const { return heap.empty(); }
+    size_t size() const { return heap.size(); }
+    int top() const { return heap.empty() ? -1 : heap.front(); }
+    // Open nodes in heap order
+    const std::vector<int>& tiles() const { return heap; }
+
+    // Nodes left in the heap belong to an older generation and are reset on
+    // their next touch, so their slots do not need clearing.
+    void clear()
+    {
+        heap.clear();
+        nextOrder = 0;
+    }
+
+    void push(std::vector<SearchNode>& nodes, int index)
+    {
+        nodes[index].openOrder = nextOrder++;
+        heap.push_back(index);
+        siftUp(nodes, static_cast<int>(heap.size()) - 1);
+    }
+
+    // Restore heap order after the node's total cost was lowered.
+    void decrease(std::vector<SearchNode>& nodes, int index)
+    {
+        if (nodes[index].isOpen())
+            siftUp(nodes, nodes[index].openIndex);
+    }
+
+    // Restore heap order after the node's costs changed in either direction.
+    void update(std::vector<SearchNode>& nodes, int index)
+    {
+        if (!nodes[index].isOpen())
+            return;
+        int slot = nodes[index].openIndex;
+        siftUp(nodes, slot);
+        siftDown(nodes, nodes[index].openIndex);
+    }
+
+    void remove(std::vector<SearchNode>& nodes, int index)
+    {
+        int slot = nodes[index].openIndex;
+        if (slot < 0)
+            return;
+
+        int last = heap.back();
+        heap.pop_back();
+        nodes[index].openIndex = -1;
+        if (slot < static_cast<int>(heap.size())) {
+            place(nodes, slot, last);
+            update(nodes, last);
+        }
+    }
+
+    int pop(std::vector<SearchNode>& nodes)
+    {
+        if (heap.empty())
+            return -1;
+
+        int top = heap.front();
+        int last = heap.back();
+        heap.pop_back();
+        if (!heap.empty()) {
+            place(nodes, 0, last);
+            siftDown(nodes, 0);
+        }
+        nodes[top].openIndex = -1;
+        return top;
+    }
+};
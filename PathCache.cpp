@@ -0,0 +1,92 @@
+#include "../Headers/PathCache.h"
+
+PathCache::PathCache(size_t capacity)
+{
+    stats.capacity = capacity;
+}
+
+bool PathCache::find(int xStart, int yStart, int xFinish, int yFinish, int sizeClass, unsigned mapVersion,
+    std::vector<std::shared_ptr<AstarTile>>& path)
+{
+    const std::vector<std::shared_ptr<AstarTile>>* cached = find(xStart, yStart, xFinish, yFinish, sizeClass, mapVersion);
+    if (!cached)
+        return false;
+
+    path = *cached;
+    return true;
+}
+
+const std::vector<std::shared_ptr<AstarTile>>* PathCache::find(int xStart, int yStart, int xFinish, int yFinish, int sizeClass,
+    unsigned mapVersion)
+{
+    if (mapVersion != this->mapVersion) {
+        clear();
+        this->mapVersion = mapVersion;
+    }
+
+    auto it = lookup.find(Key{ xStart, yStart, xFinish, yFinish, sizeClass });
+    if (it == lookup.end()) {
+        stats.misses++;
+        return nullptr;
+    }
+
+    // Move to the front, it is now the most recently used entry
+    entries.splice(entries.begin(), entries, it->second);
+    stats.hits++;
+    return &it->second->second;
+}
+
+void PathCache::insert(int xStart, int yStart, int xFinish, int yFinish, int sizeClass, unsigned mapVersion,
+    const std::vector<std::shared_ptr<AstarTile>>& path)
+{
+    if (stats.capacity == 0)
+        return;
+
+    if (mapVersion != this->mapVersion) {
+        clear();
+        this->mapVersion = mapVersion;
+    }
+
+    Key key{ xStart, yStart, xFinish, yFinish, sizeClass };
+    auto it = lookup.find(key);
+    if (it != lookup.end()) {
+        it->second->second = path;
+        entries.splice(entries.begin(), entries, it->second);
+        return;
+    }
+
+    entries.emplace_front(key, path);
+    lookup[key] = entries.begin();
+    evictOverflow();
+    stats.entries = entries.size();
+}
+
+void PathCache::clear()
+{
+    entries.clear();
+    lookup.clear();
+    stats.entries = 0;
+}
+
+void PathCache::setCapacity(size_t capacity)
+{
+    stats.capacity = capacity;
+    evictOverflow();
+    stats.entries = entries.size();
+}
+
+void PathCache::resetStats()
+{
+    stats.hits = 0;
+    stats.misses = 0;
+    stats.evictions = 0;
+}
+
+void PathCache::evictOverflow()
+{
+    while (entries.size() > stats.capacity) {
+        lookup.erase(entries.back().first);
+        entries.pop_back();
+        stats.evictions++;
+    }
+}
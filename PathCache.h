@@ -0,0 +1,75 @@
+#pragma once
+#include "AstarTile.h"
+#include <vector>
+#include <memory>
+#include <list>
+#include <unordered_map>
+#include <cstddef>
+
+struct PathCacheStats {
+    size_t hits = 0;
+    size_t misses = 0;
+    size_t evictions = 0;
+    size_t entries = 0;
+    size_t capacity = 0;
+};
+
+// Bounded LRU cache of tile paths, keyed by start tile, finish tile and agent
+// size class. Every entry belongs to one map version; asking with a newer
+// version drops the whole cache. Unreachable queries are cached as empty paths.
+class PathCache {
+private:
+    struct Key {
+        int xStart;
+        int yStart;
+        int xFinish;
+        int yFinish;
+        int sizeClass;
+
+        bool operator==(const Key& other) const
+        {
+            return xStart == other.xStart && yStart == other.yStart &&
+                xFinish == other.xFinish && yFinish == other.yFinish &&
+                sizeClass == other.sizeClass;
+        }
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key& k) const
+        {
+            size_t h = static_cast<size_t>(k.xStart);
+            h = h * 31 + static_cast<size_t>(k.yStart);
+            h = h * 31 + static_cast<size_t>(k.xFinish);
+            h = h * 31 + static_cast<size_t>(k.yFinish);
+            h = h * 31 + static_cast<size_t>(k.sizeClass);
+            return h;
+        }
+    };
+
+    using Entry = std::pair<Key, std::vector<std::shared_ptr<AstarTile>>>;
+
+    std::list<Entry> entries; // most recently used first
+    std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> lookup;
+    unsigned mapVersion = 0;
+    PathCacheStats stats;
+
+    void evictOverflow();
+
+public:
+    explicit PathCache(size_t capacity = 256);
+    ~PathCache() = default;
+
+    bool find(int xStart, int yStart, int xFinish, int yFinish, int sizeClass, unsigned mapVersion,
+        std::vector<std::shared_ptr<AstarTile>>& path);
+    // Same lookup without copying: the cached path, valid until the next insert
+    // or clear, or nullptr on a miss
+    const std::vector<std::shared_ptr<AstarTile>>* find(int xStart, int yStart, int xFinish, int yFinish, int sizeClass,
+        unsigned mapVersion);
+    void insert(int xStart, int yStart, int xFinish, int yFinish, int sizeClass, unsigned mapVersion,
+        const std::vector<std::shared_ptr<AstarTile>>& path);
+    void clear();
+
+    void setCapacity(size_t capacity);
+    const PathCacheStats& getStats() const { return stats; }
+    void resetStats();
+};
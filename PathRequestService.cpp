@@ -0,0 +1,124 @@
+#include "../Headers/PathRequestService.h"
+#include <algorithm>
+
+PathRequestService::PathRequestService(size_t workerCount)
+{
+    if (workerCount == 0) {
+        unsigned hardware = std::thread::hardware_concurrency();
+        workerCount = hardware > 1 ? hardware - 1 : 1;
+    }
+
+    for (size_t i = 0; i < workerCount; ++i)
+        workers.emplace_back(&PathRequestService::work, this);
+}
+
+PathRequestService::~PathRequestService()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    jobAdded.notify_all();
+
+    for (auto& worker : workers)
+        worker.join();
+}
+
+void PathRequestService::setMap(std::shared_ptr<const Pathfinder> map, unsigned mapVersion)
+{
+    this->map = std::move(map);
+    this->mapVersion = mapVersion;
+}
+
+unsigned PathRequestService::takeId()
+{
+    unsigned id = nextId++;
+    if (nextId == 0)
+        nextId = 1;
+    return id;
+}
+
+unsigned PathRequestService::request(int xStart, int yStart, int xFinish, int yFinish, int entitySize, const SearchOptions& options, Callback callback)
+{
+    unsigned id = takeId();
+    callbacks[id] = std::move(callback);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        jobs.push_back(Job{ id, xStart, yStart, xFinish, yFinish, entitySize, options, mapVersion, map });
+    }
+    jobAdded.notify_one();
+    return id;
+}
+
+unsigned PathRequestService::answer(std::vector<std::shared_ptr<AstarTile>> path, Callback callback)
+{
+    unsigned id = takeId();
+    callbacks[id] = std::move(callback);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    results.push_back(Result{ id, std::move(path) });
+    return id;
+}
+
+void PathRequestService::cancel(unsigned id)
+{
+    if (callbacks.erase(id) == 0)
+        return;
+
+    // Drop it from the queue if no worker picked it up yet
+    std::lock_guard<std::mutex> lock(mutex);
+    jobs.erase(std::remove_if(jobs.begin(), jobs.end(), [id](const Job& job) { return job.id == id; }), jobs.end());
+}
+
+size_t PathRequestService::deliver(size_t maxResults)
+{
+    std::vector<Result> ready;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        while (!results.empty() && ready.size() < maxResults) {
+            ready.push_back(std::move(results.front()));
+            results.pop_front();
+        }
+    }
+
+    // Callbacks run without the lock, they may queue new requests
+    size_t delivered = 0;
+    for (auto& result : ready) {
+        auto it = callbacks.find(result.id);
+        if (it == callbacks.end())
+            continue; // cancelled while searching
+
+        Callback callback = std::move(it->second);
+        callbacks.erase(it);
+        callback(result.path);
+        delivered++;
+    }
+    return delivered;
+}
+
+void PathRequestService::work()
+{
+    // Search scratch of this thread, the maps themselves are shared
+    SearchContext context;
+
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            jobAdded.wait(lock, [this] { return stopping || !jobs.empty(); });
+            if (stopping)
+                return;
+            job = std::move(jobs.front());
+            jobs.pop_front();
+        }
+
+        std::vector<std::shared_ptr<AstarTile>> path;
+        if (job.map) {
+            context.setEntitySize(job.entitySize);
+            path = job.map->newPath(context, job.xStart, job.yStart, job.xFinish, job.yFinish, job.options);
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        results.push_back(Result{ job.id, std::move(path) });
+    }
+}
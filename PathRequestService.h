@@ -0,0 +1,81 @@
+#pragma once
+#include "Pathfinder.h"
+#include <vector>
+#include <memory>
+#include <deque>
+#include <functional>
+#include <unordered_map>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+
+// Runs path queries on a pool of worker threads. Each worker searches the
+// read-only map a request was made against with its own SearchContext, so the
+// caller's Pathfinder is never touched off the main thread. Finished paths wait in a
+// queue until deliver() hands a bounded number of them to their callbacks on
+// the calling thread. request(), cancel(), setMap() and deliver() belong to
+// one thread (the game loop); only the queues are shared with the workers.
+class PathRequestService {
+public:
+    using Callback = std::function<void(const std::vector<std::shared_ptr<AstarTile>>& path)>;
+
+private:
+    struct Job {
+        unsigned id;
+        int xStart;
+        int yStart;
+        int xFinish;
+        int yFinish;
+        int entitySize;
+        SearchOptions options;
+        unsigned mapVersion;
+        std::shared_ptr<const Pathfinder> map;
+    };
+
+    struct Result {
+        unsigned id;
+        std::vector<std::shared_ptr<AstarTile>> path;
+    };
+
+    std::vector<std::thread> workers;
+    std::deque<Job> jobs;
+    std::deque<Result> results;
+    std::mutex mutex;
+    std::condition_variable jobAdded;
+    bool stopping = false;
+
+    // Caller side only
+    std::shared_ptr<const Pathfinder> map;
+    unsigned mapVersion = 0;
+    unsigned nextId = 1;
+    std::unordered_map<unsigned, Callback> callbacks;
+
+    void work();
+    unsigned takeId();
+
+public:
+    // 0 workers picks one less than the hardware threads, at least one
+    explicit PathRequestService(size_t workerCount = 0);
+    ~PathRequestService();
+
+    PathRequestService(const PathRequestService&) = delete;
+    PathRequestService& operator=(const PathRequestService&) = delete;
+
+    // Map that later requests search; requests already queued keep theirs
+    void setMap(std::shared_ptr<const Pathfinder> map, unsigned mapVersion);
+
+    // Queue a query, returns its handle (never 0). The callback runs inside deliver().
+    unsigned request(int xStart, int yStart, int xFinish, int yFinish, int entitySize, const SearchOptions& options, Callback callback);
+    // Queue a result known without searching, e.g. for a query that cannot
+    // succeed; the callback still runs inside deliver()
+    unsigned answer(std::vector<std::shared_ptr<AstarTile>> path, Callback callback);
+    // The callback of a cancelled request is never called
+    void cancel(unsigned id);
+    // False once the callback has run, or the request was cancelled
+    bool isPending(unsigned id) const { return callbacks.count(id) != 0; }
+    // Run the callbacks of at most maxResults finished requests, returns how many ran
+    size_t deliver(size_t maxResults);
+
+    size_t getPendingCount() const { return callbacks.size(); }
+    size_t getWorkerCount() const { return workers.size(); }
+};
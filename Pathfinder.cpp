@@ -1,318 +1,1200 @@
-#include "../Headers/Pathfinder.h"
-#include <algorithm>
-#include <cmath>
-
-Pathfinder::Pathfinder(int mapWidth, int mapHeight, int entityWidth, int entityHeight)
-{
-    this->mapWidth = mapWidth;
-    this->mapHeight = mapHeight;
-    this->entityWidth = entityWidth;
-    this->entityHeight = entityHeight;
-
-    if (mapWidth <= 0 || mapHeight <= 0)
-        return;
-
-    aTiles.resize(mapWidth,
-        std::vector<std::shared_ptr<AstarTile>>(mapHeight, nullptr));
-}
-
-std::vector<std::shared_ptr<AstarTile>>
-Pathfinder::newPath(int xStart, int yStart, int xFinish, int yFinish)
-{
-    if (tiles.empty())
-        return {};
-
-    if (hasCollision(xFinish, yFinish))
-        return {};
-
-    if (xStart != this->xStart || yStart != this->yStart ||
-        xFinish != this->xFinish || yFinish != this->yFinish)
-    {
-        this->xStart = xStart;
-        this->yStart = yStart;
-        this->xFinish = xFinish;
-        this->yFinish = yFinish;
-
-        if (xStart == xFinish && yStart == yFinish) {
-            path.clear();
-            path.push_back(std::make_shared<AstarTile>(xStart, yStart, false));
-            return path;
-        }
-
-        return searchTiles();
-    }
-    return path;
-}
-
-
-std::vector<std::shared_ptr<AstarTile>> Pathfinder::searchTiles()
-{
-    first = true;
-    std::shared_ptr<AstarTile> tile = nullptr;
-
-    while (true) {
-        tile = nullptr;
-
-        if (first) {
-            first = false;
-
-            for (int x = 0; x < mapWidth; ++x)
-                for (int y = 0; y < mapHeight; ++y)
-                    aTiles[x][y] = nullptr;
-
-            markedATiles.clear();
-
-            for (int y = 0; y < mapHeight; ++y) {
-                for (int x = 0; x < mapWidth; ++x) {
-
-                    if (x >= tiles.size() || y >= tiles[x].size())
-                        continue;
-
-                    // Null pointer safety
-                    if (!tiles[x][y])
-                        continue;
-
-                    auto t = std::make_shared<AstarTile>(
-                        x, y,
-                        hasCollision(x, y),
-                        tiles[x][y]->getWeight()
-                    );
-
-                    aTiles[x][y] = t;
-
-                    if (!t->hasCollision()) {
-                        t->setFinishDiff(phyt(xFinish, yFinish, x, y));
-                        t->setTotalCost();
-                    }
-
-                    if (x == xFinish && y == yFinish)
-                        t->setFinish(true);
-                }
-            }
-            auto startTile = getTile(xStart, yStart);
-            if (turnOver(startTile))
-                return backtrackPath(tile);
-        }
-        else {
-            int lowestScore = findLowestScore();
-            tile = closestFinish(lowestScore);
-
-            if (!tile)
-                return {};
-
-            if (turnOver(tile))
-                return backtrackPath(tile);
-        }
-    }
-}
-
-std::shared_ptr<AstarTile> Pathfinder::closestFinish(int lowestScore)
-{
-    std::shared_ptr<AstarTile> tile = nullptr;
-    int closestFinish = 0;
-
-    for (auto& t : markedATiles) {
-        int tCost = t->getTotalCost();
-        if (tCost == lowestScore) {
-            int fCost = t->getFinishCost();
-            if (!tile || fCost < closestFinish) {
-                closestFinish = fCost;
-                tile = t;
-            }
-        }
-    }
-    return tile;
-}
-
-int Pathfinder::findLowestScore()
-{
-    int lowestScore = 0;
-    std::shared_ptr<AstarTile> tile = nullptr;
-
-    for (auto& t : markedATiles) {
-        int tCost = t->getTotalCost();
-        if (!tile || tCost < lowestScore) {
-            lowestScore = tCost;
-            tile = t;
-        }
-    }
-    return lowestScore;
-}
-
-bool Pathfinder::turnOver(std::shared_ptr<AstarTile>& tile)
-{
-    if (!tile)
-        return false;
-
-    int x1 = tile->getX();
-    int y1 = tile->getY();
-
-    for (int y = y1 - 1; y <= y1 + 1; ++y) {
-        for (int x = x1 - 1; x <= x1 + 1; ++x) {
-
-            auto t = getTile(x, y);
-            if (!t || t->hasCollision())
-                continue;
-
-            if (x == x1 && y == y1) {
-                t->setChecked(true);
-                markedATiles.erase(
-                    std::remove(markedATiles.begin(), markedATiles.end(), t),
-                    markedATiles.end()
-                );
-                if (t->isFinish())
-                    return true;
-            }
-
-            if (!t->getChecked() &&
-                diagonalDir(x1, y1, x, y))
-            {
-                int moveCost = phyt(x, y, x1, y1) * t->getWeight();
-                int newCost = moveCost + tile->getStartCost();
-
-                auto it = std::find(markedATiles.begin(), markedATiles.end(), t);
-                bool contains = it != markedATiles.end();
-
-                if (!contains || t->getStartCost() > newCost) {
-                    t->setStartDiff(newCost);
-                    t->setTotalCost();
-                    t->setParent(tile);
-                }
-
-                if (!contains)
-                    markedATiles.push_back(t);
-            }
-        }
-    }
-    return false;
-}
-
-bool Pathfinder::diagonalDir(int xParent, int yParent, int xNext, int yNext)
-{
-    int dx = xParent - xNext;
-    int dy = yParent - yNext;
-
-    if (dx != 0 && dy != 0) {
-        auto t1 = getTile(xNext + dx, yNext);
-        auto t2 = getTile(xNext, yNext + dy);
-
-        if ((t1 && t1->hasCollision()) ||
-            (t2 && t2->hasCollision()))
-            return false;
-    }
-    return true;
-}
-
-std::shared_ptr<AstarTile> Pathfinder::getTile(int x, int y)
-{
-    if (x >= 0 && x < mapWidth && y >= 0 && y < mapHeight)
-        return aTiles[x][y];
-    return nullptr;
-}
-
-std::vector<std::shared_ptr<AstarTile>>
-Pathfinder::backtrackPath(std::shared_ptr<AstarTile>& finishTile)
-{
-    path.clear();
-
-    // 1) backtrack
-    for (auto t = finishTile; t; t = t->getParentTile())
-        path.push_back(t);
-
-    // 2) reverse
-    std::reverse(path.begin(), path.end());
-
-    if (path.size() < 3)
-        return path;
-
-    // 3) remove collinear points
-    std::vector<std::shared_ptr<AstarTile>> filtered;
-    filtered.push_back(path[0]);
-
-    for (size_t i = 1; i + 1 < path.size(); ++i) {
-        if (!isCollinear(*filtered.back(), *path[i], *path[i + 1]))
-            filtered.push_back(path[i]);
-    }
-    filtered.push_back(path.back());
-
-    // 4) line-of-sight pruning
-    std::vector<std::shared_ptr<AstarTile>> optimized;
-    optimized.push_back(filtered[0]);
-
-    size_t anchor = 0;
-    for (size_t i = 2; i < filtered.size(); ++i) {
-        if (!hasLineOfSight(*filtered[anchor], *filtered[i])) {
-            optimized.push_back(filtered[i - 1]);
-            anchor = i - 1;
-        }
-    }
-    optimized.push_back(filtered.back());
-
-    path = std::move(optimized);
-    return path;
-}
-
-
-int Pathfinder::phyt(int xStart, int yStart, int xPos, int yPos)
-{
-    int dx = std::abs(xStart - xPos);
-    int dy = std::abs(yStart - yPos);
-
-    int cost = 0;
-    while (dx > 0 && dy > 0) {
-        dx--; dy--;
-        cost += 14;
-    }
-    return cost + dx * 10 + dy * 10;
-}
-
-bool Pathfinder::hasCollision(int x, int y)
-{
-    if (tiles.empty())
-        return true;
-
-    for (int i = 0; i < entityWidth; ++i) {
-        for (int j = 0; j < entityHeight; ++j) {
-
-            int tx = x + i;
-            int ty = y + j;
-
-            if (tx < 0 || ty < 0 || tx >= mapWidth || ty >= mapHeight)
-                return true;
-
-            if (!tiles[tx][ty] || tiles[tx][ty]->hasCollision())
-                return true;
-        }
-    }
-    return false;
-}
-
-bool Pathfinder::hasLineOfSight(
-    const AstarTile& from,
-    const AstarTile& to)
-{
-    int x0 = from.getX();
-    int y0 = from.getY();
-    int x1 = to.getX();
-    int y1 = to.getY();
-
-    int dx = std::abs(x1 - x0);
-    int dy = std::abs(y1 - y0);
-    int sx = (x0 < x1) ? 1 : -1;
-    int sy = (y0 < y1) ? 1 : -1;
-    int err = dx - dy;
-
-    while (true) {
-        // entity-sized collision check
-        if (hasCollision(x0, y0))
-            return false;
-
-        if (x0 == x1 && y0 == y1)
-            break;
-
-        int e2 = 2 * err;
-        if (e2 > -dy) { err -= dy; x0 += sx; }
-        if (e2 < dx) { err += dx; y0 += sy; }
-    }
-    return true;
-}
+#include "../Headers/Pathfinder.h"
+#include <algorithm>
+#include <cmath>
+#include <chrono>
+#include <climits>
+
+Pathfinder::Pathfinder(int mapWidth, int mapHeight, int entitySize)
+    : context(entitySize)
+{
+    this->mapWidth = mapWidth;
+    this->mapHeight = mapHeight;
+    grid = std::make_shared<const NavGrid>();
+}
+
+Pathfinder::Pathfinder(std::shared_ptr<const NavGrid> grid, int entitySize)
+    : context(entitySize)
+{
+    if (!grid)
+        grid = std::make_shared<const NavGrid>();
+
+    this->grid = std::move(grid);
+    mapWidth = this->grid->getWidth();
+    mapHeight = this->grid->getHeight();
+}
+
+void Pathfinder::setTileMap(const std::vector<std::vector<std::shared_ptr<AstarTile>>>& tileMap)
+{
+    if (tileMap.empty() || tileMap[0].empty()) {
+        loadMap(OccupancyGrid(), {});
+        return;
+    }
+
+    // The map may have been regenerated with a different size
+    const int width = static_cast<int>(tileMap.size());
+    const int height = static_cast<int>(tileMap[0].size());
+
+    OccupancyGrid occupancy(width, height);
+    std::vector<int> tileWeights(static_cast<size_t>(width) * height, 1);
+    bool uniform = true;
+
+    for (int x = 0; x < width; ++x) {
+        for (int y = 0; y < height; ++y) {
+            const auto* tile = y < static_cast<int>(tileMap[x].size()) ? tileMap[x][y].get() : nullptr;
+            if (!tile) {
+                occupancy.setBlocked(x, y, true);
+                continue;
+            }
+            occupancy.setBlocked(x, y, tile->hasCollision());
+            tileWeights[static_cast<size_t>(y) * width + x] = tile->getWeight();
+            if (tile->getWeight() != 1)
+                uniform = false;
+        }
+    }
+
+    if (uniform)
+        tileWeights.clear();
+    loadMap(occupancy, std::move(tileWeights));
+}
+
+void Pathfinder::setOccupancy(const OccupancyGrid& grid)
+{
+    loadMap(grid, {});
+}
+
+void Pathfinder::updateOccupancy(const OccupancyGrid& occupancy, const std::vector<int>& changedTiles)
+{
+    // A map of another size has no tiles in common with this one
+    if (grid->empty() || occupancy.getWidth() != grid->getWidth() || occupancy.getHeight() != grid->getHeight()) {
+        loadMap(occupancy, {});
+        return;
+    }
+    useGrid(std::make_shared<const NavGrid>(*grid, occupancy, changedTiles));
+}
+
+void Pathfinder::loadMap(const OccupancyGrid& occupancy, std::vector<int> weights)
+{
+    useGrid(std::make_shared<const NavGrid>(occupancy, std::move(weights)));
+}
+
+void Pathfinder::useGrid(std::shared_ptr<const NavGrid> grid)
+{
+    this->grid = std::move(grid);
+    bind(context);
+
+    if (this->grid->empty())
+        return;
+
+    mapWidth = this->grid->getWidth();
+    mapHeight = this->grid->getHeight();
+
+    // Other entity sizes get their jump table on first use
+    if (this->grid->hasUniformWeights())
+        this->grid->getJumpTable(context.entitySize);
+}
+
+// A context that last searched another grid forgets that query
+void Pathfinder::bind(SearchContext& context) const
+{
+    if (context.gridSerial == grid->getSerial())
+        return;
+
+    context.gridSerial = grid->getSerial();
+    context.forgetQuery();
+    context.slice = SearchContext::SlicedQuery();
+}
+
+std::vector<std::shared_ptr<AstarTile>>
+Pathfinder::newPath(SearchContext& context, int xStart, int yStart, int xFinish, int yFinish, const SearchOptions& options) const
+{
+    if (grid->empty())
+        return {};
+
+    bind(context);
+    if (hasCollision(context, xFinish, yFinish))
+        return {};
+
+    if (xStart != context.xStart || yStart != context.yStart ||
+        xFinish != context.xFinish || yFinish != context.yFinish ||
+        options != context.options)
+    {
+        context.xStart = xStart;
+        context.yStart = yStart;
+        context.xFinish = xFinish;
+        context.yFinish = yFinish;
+        context.options = options;
+        context.bound = 0.0f;
+
+        if (xStart == xFinish && yStart == yFinish) {
+            context.path.clear();
+            context.path.push_back(std::make_shared<AstarTile>(xStart, yStart, false));
+            context.bound = 1.0f;
+            return context.path;
+        }
+
+        switch (options.mode) {
+        case SearchMode::AStar:
+            return searchTiles(context);
+        case SearchMode::Bidirectional:
+            return searchBidirectional(context);
+        case SearchMode::Anytime:
+            return searchAnytime(context);
+        case SearchMode::LazyTheta:
+            // A straight line over tiles of different weight has no single cost
+            return grid->hasUniformWeights() ? searchTheta(context) : searchTiles(context);
+        default:
+            // Uniform cost maps have many symmetric paths, jump point search skips them
+            return grid->hasUniformWeights() ? searchJumps(context) : searchTiles(context);
+        }
+    }
+    return context.path;
+}
+
+
+std::vector<std::shared_ptr<AstarTile>> Pathfinder::searchTiles(SearchContext& context) const
+{
+    context.path.clear();
+
+    if (!inBounds(context.xStart, context.yStart))
+        return context.path;
+
+    beginSearch(context, fullRegion(), false);
+    context.finishIndex = index(context.xFinish, context.yFinish);
+    context.heuristicWeight = (std::max)(1.0f, context.options.weight);
+
+    int finish = runSearch(context, index(context.xStart, context.yStart));
+    if (finish < 0)
+        return context.path;
+    context.bound = context.heuristicWeight;
+    return backtrackPath(context, finish);
+}
+
+int Pathfinder::searchRegion(SearchContext& context, int xStart, int yStart, int xFinish, int yFinish, const Region& region, std::vector<int>* route) const
+{
+    if (grid->empty() || !region.contains(xStart, yStart) ||
+        !region.contains(xFinish, yFinish) || !walkable(context, xFinish, yFinish))
+        return -1;
+
+    bind(context);
+    beginSearch(context, region, false);
+    context.finishIndex = index(xFinish, yFinish);
+
+    int finish = runSearch(context, index(xStart, yStart));
+    if (finish < 0)
+        return -1;
+
+    if (route)
+        *route = backtrackRoute(context, finish);
+    return context.nodes[finish].startCost;
+}
+
+void Pathfinder::floodRegion(SearchContext& context, int xSource, int ySource, const Region& region, bool reverse,
+    const std::atomic<bool>* cancel) const
+{
+    if (grid->empty() || !region.contains(xSource, ySource))
+        return;
+
+    bind(context);
+    beginSearch(context, region, reverse);
+    context.finishIndex = -1;
+    if (!cancel) {
+        runSearch(context, index(xSource, ySource));
+        return;
+    }
+
+    // runSearch, looking at the flag every few thousand tiles
+    const int source = index(xSource, ySource);
+    touch(context, source);
+    int expansions = 0;
+    for (int tile = source; tile >= 0; tile = context.openTiles.pop(context.nodes)) {
+        if (++expansions % 4096 == 0 && cancel->load(std::memory_order_relaxed))
+            return;
+        turnOver(context, tile);
+    }
+}
+
+int Pathfinder::costTo(const SearchContext& context, int x, int y) const
+{
+    if (!inBounds(x, y) || static_cast<size_t>(index(x, y)) >= context.nodes.size())
+        return -1;
+
+    const SearchNode& n = context.nodes[index(x, y)];
+    if (n.generation != context.generation || !n.closed)
+        return -1;
+    return n.startCost;
+}
+
+int Pathfinder::parentOf(const SearchContext& context, int x, int y) const
+{
+    if (costTo(context, x, y) < 0)
+        return -1;
+    return context.nodes[index(x, y)].parent;
+}
+
+int Pathfinder::runSearch(SearchContext& context, int start) const
+{
+    touch(context, start);
+
+    int tile = start;
+    while (tile >= 0) {
+        if (turnOver(context, tile))
+            return tile;
+
+        tile = context.openTiles.pop(context.nodes);
+    }
+    return -1;
+}
+
+std::vector<std::shared_ptr<AstarTile>> Pathfinder::searchJumps(SearchContext& context) const
+{
+    context.path.clear();
+
+    if (!inBounds(context.xStart, context.yStart))
+        return context.path;
+
+    beginSearch(context, fullRegion(), false);
+    context.finishIndex = index(context.xFinish, context.yFinish);
+    context.jumpTable = grid->getJumpTable(context.entitySize).data();
+    context.heuristicWeight = (std::max)(1.0f, context.options.weight);
+
+    int tile = index(context.xStart, context.yStart);
+    touch(context, tile);
+
+    while (tile >= 0) {
+        context.nodes[tile].closed = true;
+        if (tile == context.finishIndex) {
+            context.bound = context.heuristicWeight;
+            return backtrackPath(context, tile);
+        }
+
+        jumpSuccessors(context, tile);
+        tile = context.openTiles.pop(context.nodes);
+    }
+    return context.path;
+}
+
+std::vector<std::shared_ptr<AstarTile>> Pathfinder::searchBidirectional(SearchContext& context) const
+{
+    context.path.clear();
+
+    if (!inBounds(context.xStart, context.yStart))
+        return context.path;
+
+    std::vector<int> route;
+    if (bidirectionalRoute(context, index(context.xStart, context.yStart), index(context.xFinish, context.yFinish), route) < 0)
+        return context.path;
+
+    context.path = smoothRoute(context, std::move(route));
+    context.bound = 1.0f;
+    return context.path;
+}
+
+// A* from the start and from the finish at once, on whichever side has the
+// smaller frontier. Both sides use the average of the two octile estimates,
+// (h to finish - h to start) / 2 and its negation, which makes them one search
+// over the same reduced costs that can stop where the frontiers meet: once the
+// two lowest keys add up to best, the cheapest route through a tile reached by
+// both sides, nothing cheaper is left. Keys are doubled to stay integral.
+int Pathfinder::bidirectionalRoute(SearchContext& context, int start, int finish, std::vector<int>& route) const
+{
+    beginSearch(context, fullRegion(), false);
+    context.finishIndex = finish;
+    context.backwardOpen.clear();
+    if (context.backwardNodes.size() != context.nodes.size())
+        context.backwardNodes.assign(context.nodes.size(), SearchNode());
+
+    touchSide(context, false, start, start, finish);
+    context.openTiles.push(context.nodes, start);
+    touchSide(context, true, finish, start, finish);
+    context.backwardOpen.push(context.backwardNodes, finish);
+
+    int best = INT_MAX;
+    int meet = -1;
+    if (start == finish) {
+        best = 0;
+        meet = start;
+    }
+
+    while (!context.openTiles.empty() && !context.backwardOpen.empty()) {
+        const long long forwardTop = context.nodes[context.openTiles.top()].totalCost;
+        const long long backwardTop = context.backwardNodes[context.backwardOpen.top()].totalCost;
+        if (meet >= 0 && forwardTop + backwardTop >= 2LL * best)
+            break;
+
+        if (context.openTiles.size() <= context.backwardOpen.size())
+            expandSide(context, false, context.openTiles.pop(context.nodes), start, finish, best, meet);
+        else
+            expandSide(context, true, context.backwardOpen.pop(context.backwardNodes), start, finish, best, meet);
+    }
+
+    if (meet < 0)
+        return -1;
+
+    // Forward parents lead back to the start, backward parents on to the finish
+    route.clear();
+    for (int t = meet; t >= 0; t = context.nodes[t].parent)
+        route.push_back(t);
+    std::reverse(route.begin(), route.end());
+    for (int t = context.backwardNodes[meet].parent; t >= 0; t = context.backwardNodes[t].parent)
+        route.push_back(t);
+    return best;
+}
+
+SearchNode& Pathfinder::touchSide(SearchContext& context, bool backward, int index, int start, int finish) const
+{
+    SearchNode& n = backward ? context.backwardNodes[index] : context.nodes[index];
+    if (n.generation != context.generation) {
+        n = SearchNode();
+        n.generation = context.generation;
+        const int x = index % mapWidth;
+        const int y = index / mapWidth;
+        const int potential = phyt(x, y, finish % mapWidth, finish / mapWidth) - phyt(x, y, start % mapWidth, start / mapWidth);
+        n.finishCost = backward ? -potential : potential;
+        n.totalCost = n.finishCost;
+    }
+    return n;
+}
+
+// Expands one tile of a bidirectional search. The backward side walks each
+// edge against its direction, so it pays for the tile it steps out of.
+void Pathfinder::expandSide(SearchContext& context, bool backward, int current, int start, int finish, int& best, int& meet) const
+{
+    std::vector<SearchNode>& nodes = backward ? context.backwardNodes : context.nodes;
+    const std::vector<SearchNode>& other = backward ? context.nodes : context.backwardNodes;
+    OpenList& open = backward ? context.backwardOpen : context.openTiles;
+
+    nodes[current].closed = true;
+    const int x1 = current % mapWidth;
+    const int y1 = current / mapWidth;
+
+    for (int y = y1 - 1; y <= y1 + 1; ++y) {
+        for (int x = x1 - 1; x <= x1 + 1; ++x) {
+            if ((x == x1 && y == y1) || !walkable(context, x, y) || !diagonalDir(context, x1, y1, x, y))
+                continue;
+
+            int i = index(x, y);
+            SearchNode& t = touchSide(context, backward, i, start, finish);
+            if (t.closed)
+                continue;
+
+            int newCost = nodes[current].startCost + phyt(x, y, x1, y1) * grid->weightAt(backward ? current : i);
+            bool contains = t.isOpen();
+            if (contains && t.startCost <= newCost)
+                continue;
+
+            t.startCost = newCost;
+            t.totalCost = 2 * newCost + t.finishCost;
+            t.parent = current;
+            if (contains)
+                open.decrease(nodes, i);
+            else
+                open.push(nodes, i);
+
+            // Reached from both ends: a complete route runs through this tile
+            const SearchNode& o = other[i];
+            if (o.generation == context.generation && (o.closed || o.isOpen()) && newCost + o.startCost < best) {
+                best = newCost + o.startCost;
+                meet = i;
+            }
+        }
+    }
+}
+
+// Lazy Theta*: a successor provisionally takes over the parent of the tile
+// that opened it, as if the line between them were clear. The line is only
+// tested when the successor is expanded (settleTheta), which is far fewer
+// tests than checking every successor. Waypoints come out as the corners
+// of an any-angle path, so no smoothing pass follows.
+std::vector<std::shared_ptr<AstarTile>> Pathfinder::searchTheta(SearchContext& context) const
+{
+    context.path.clear();
+
+    if (!inBounds(context.xStart, context.yStart))
+        return context.path;
+
+    beginSearch(context, fullRegion(), false);
+    context.finishIndex = index(context.xFinish, context.yFinish);
+    const int xFinish = context.xFinish;
+    const int yFinish = context.yFinish;
+    std::vector<SearchNode>& nodes = context.nodes;
+
+    // Straight-line estimates; the octile ones overestimate any-angle routes
+    auto open = [&](int i) -> SearchNode& {
+        SearchNode& n = nodes[i];
+        if (n.generation != context.generation) {
+            n = SearchNode();
+            n.generation = context.generation;
+            n.finishCost = euclid(i % mapWidth, i / mapWidth, xFinish, yFinish);
+            n.totalCost = n.finishCost;
+        }
+        return n;
+    };
+
+    int tile = index(context.xStart, context.yStart);
+    open(tile);
+
+    while (tile >= 0) {
+        settleTheta(context, tile);
+        nodes[tile].closed = true;
+        if (tile == context.finishIndex) {
+            std::vector<std::shared_ptr<AstarTile>> corners;
+            for (int t : backtrackRoute(context, tile))
+                corners.push_back(std::make_shared<AstarTile>(t % mapWidth, t / mapWidth, false));
+            context.path = std::move(corners);
+            return context.path;
+        }
+
+        const int x1 = tile % mapWidth;
+        const int y1 = tile / mapWidth;
+        const int parent = nodes[tile].parent >= 0 ? nodes[tile].parent : tile;
+        const int xParent = parent % mapWidth;
+        const int yParent = parent / mapWidth;
+
+        for (int y = y1 - 1; y <= y1 + 1; ++y) {
+            for (int x = x1 - 1; x <= x1 + 1; ++x) {
+                if ((x == x1 && y == y1) || !walkable(context, x, y) || !diagonalDir(context, x1, y1, x, y))
+                    continue;
+
+                int i = index(x, y);
+                SearchNode& t = open(i);
+                if (t.closed)
+                    continue;
+
+                int newCost = nodes[parent].startCost + euclid(xParent, yParent, x, y);
+                bool contains = t.isOpen();
+                if (contains && t.startCost <= newCost)
+                    continue;
+
+                t.startCost = newCost;
+                t.totalCost = newCost + t.finishCost;
+                t.parent = parent;
+                if (contains)
+                    context.openTiles.decrease(nodes, i);
+                else
+                    context.openTiles.push(nodes, i);
+            }
+        }
+        tile = context.openTiles.pop(nodes);
+    }
+    return context.path;
+}
+
+// Expansion time check of a Lazy Theta* tile: without a line of sight to the
+// parent it was given, it falls back to the best closed neighbour, which
+// always exists because one of them opened it.
+void Pathfinder::settleTheta(SearchContext& context, int current) const
+{
+    std::vector<SearchNode>& nodes = context.nodes;
+    SearchNode& n = nodes[current];
+    if (n.parent < 0 || hasLineOfSight(context, n.parent, current))
+        return;
+
+    const int x1 = current % mapWidth;
+    const int y1 = current / mapWidth;
+    n.startCost = INT_MAX;
+    for (int y = y1 - 1; y <= y1 + 1; ++y) {
+        for (int x = x1 - 1; x <= x1 + 1; ++x) {
+            if ((x == x1 && y == y1) || !walkable(context, x, y) || !diagonalDir(context, x1, y1, x, y))
+                continue;
+
+            const SearchNode& neighbour = nodes[index(x, y)];
+            if (neighbour.generation != context.generation || !neighbour.closed)
+                continue;
+
+            int cost = neighbour.startCost + euclid(x, y, x1, y1);
+            if (cost < n.startCost) {
+                n.startCost = cost;
+                n.parent = index(x, y);
+            }
+        }
+    }
+    n.totalCost = n.startCost + n.finishCost;
+}
+
+// ARA*: weighted A* passes with a falling weight. A pass keeps the costs
+// found by the one before and only reopens the tiles whose cost dropped after
+// they were expanded, so improving a path is much cheaper than searching again.
+// The first path is always completed; the budget only limits the passes after
+// it, and a pass cut short leaves the last complete path in place.
+std::vector<std::shared_ptr<AstarTile>> Pathfinder::searchAnytime(SearchContext& context) const
+{
+    context.path.clear();
+
+    if (!inBounds(context.xStart, context.yStart))
+        return context.path;
+
+    const SearchOptions& options = context.options;
+    beginSearch(context, fullRegion(), false);
+    context.finishIndex = index(context.xFinish, context.yFinish);
+    context.heuristicWeight = (std::max)(1.0f, options.weight);
+    context.expanded.clear();
+    context.inconsistent.clear();
+
+    int start = index(context.xStart, context.yStart);
+    touch(context, start);
+    context.openTiles.push(context.nodes, start);
+
+    int unlimited = -1;
+    if (improveAnytime(context, unlimited, std::chrono::steady_clock::time_point::max()) != SearchStatus::Found)
+        return context.path;
+
+    std::vector<int> route = backtrackRoute(context, context.finishIndex);
+    float bound = anytimeBound(context);
+
+    int expansionsLeft = options.budget.maxExpansions > 0 ? options.budget.maxExpansions : -1;
+    auto deadline = std::chrono::steady_clock::time_point::max();
+    if (options.budget.maxMicroseconds > 0)
+        deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(options.budget.maxMicroseconds);
+    const float step = options.weightStep > 0.0f ? options.weightStep : 0.5f;
+
+    float weight = context.heuristicWeight;
+    while (weight > 1.0f && bound > 1.0f) {
+        // The achieved bound may already be below the next step
+        weight = (std::max)(1.0f, (std::min)(weight - step, bound));
+        reweightAnytime(context, weight);
+        if (improveAnytime(context, expansionsLeft, deadline) != SearchStatus::Found)
+            break;
+
+        route = backtrackRoute(context, context.finishIndex);
+        bound = anytimeBound(context);
+    }
+
+    context.bound = bound;
+    context.path = smoothRoute(context, std::move(route));
+    return context.path;
+}
+
+// One ARA* pass: expands until no open tile can lead to the finish for less
+// than its current cost, with the open costs inflated by the pass weight.
+// Returns Searching when the budget runs out first.
+SearchStatus Pathfinder::improveAnytime(SearchContext& context, int& expansionsLeft, std::chrono::steady_clock::time_point deadline) const
+{
+    std::vector<SearchNode>& nodes = context.nodes;
+    const SearchNode& finish = nodes[context.finishIndex];
+    const bool timed = deadline != std::chrono::steady_clock::time_point::max();
+    int expansions = 0;
+
+    while (!context.openTiles.empty()) {
+        int current = context.openTiles.top();
+        if (finish.generation == context.generation && finish.startCost <= nodes[current].totalCost)
+            return SearchStatus::Found;
+
+        if (expansionsLeft == 0)
+            return SearchStatus::Searching;
+        if (expansionsLeft > 0)
+            expansionsLeft--;
+        // Reading the clock costs about as much as an expansion, so only every 16th
+        if (timed && (++expansions & 15) == 0 && std::chrono::steady_clock::now() >= deadline)
+            return SearchStatus::Searching;
+
+        context.openTiles.pop(nodes);
+        nodes[current].closed = true;
+        context.expanded.push_back(current);
+
+        const int x1 = current % mapWidth;
+        const int y1 = current / mapWidth;
+        for (int y = y1 - 1; y <= y1 + 1; ++y) {
+            for (int x = x1 - 1; x <= x1 + 1; ++x) {
+                if ((x == x1 && y == y1) || !walkable(context, x, y) || !diagonalDir(context, x1, y1, x, y))
+                    continue;
+
+                int i = index(x, y);
+                SearchNode& t = nodes[i];
+                if (t.generation != context.generation) {
+                    touch(context, i);
+                    t.startCost = INT_MAX;
+                }
+
+                int newCost = nodes[current].startCost + phyt(x, y, x1, y1) * grid->weightAt(i);
+                if (newCost >= t.startCost)
+                    continue;
+
+                t.startCost = newCost;
+                t.parent = current;
+                // Expanded tiles wait for the next pass instead of being expanded twice
+                if (t.closed) {
+                    context.inconsistent.push_back(i);
+                    continue;
+                }
+
+                if (t.isOpen()) {
+                    t.totalCost = newCost + t.finishCost;
+                    context.openTiles.decrease(nodes, i);
+                    continue;
+                }
+
+                // Tiles expanded in an earlier pass still carry that pass's estimate
+                t.finishCost = static_cast<int>(estimate(context, i) * context.heuristicWeight);
+                t.totalCost = newCost + t.finishCost;
+                context.openTiles.push(nodes, i);
+            }
+        }
+    }
+
+    if (finish.generation == context.generation && finish.startCost < INT_MAX)
+        return SearchStatus::Found;
+    return SearchStatus::NoPath;
+}
+
+// Starts the next ARA* pass: nothing is expanded yet, and the open and
+// inconsistent tiles are queued again with estimates under the new weight.
+void Pathfinder::reweightAnytime(SearchContext& context, float weight) const
+{
+    std::vector<SearchNode>& nodes = context.nodes;
+    context.heuristicWeight = weight;
+    for (int i : context.expanded)
+        nodes[i].closed = false;
+    context.expanded.clear();
+
+    std::vector<int> queued = context.openTiles.tiles();
+    queued.insert(queued.end(), context.inconsistent.begin(), context.inconsistent.end());
+    context.inconsistent.clear();
+    for (int i : context.openTiles.tiles())
+        nodes[i].openIndex = -1;
+    context.openTiles.clear();
+
+    for (int i : queued) {
+        if (nodes[i].isOpen())
+            continue;
+        nodes[i].finishCost = static_cast<int>(estimate(context, i) * weight);
+        nodes[i].totalCost = nodes[i].startCost + nodes[i].finishCost;
+        context.openTiles.push(nodes, i);
+    }
+}
+
+// Suboptimality proven after an ARA* pass: every cheaper route to the finish
+// would have to pass an open or inconsistent tile, so the lowest uninflated
+// estimate among them is a lower bound on the optimal cost.
+float Pathfinder::anytimeBound(const SearchContext& context) const
+{
+    const std::vector<SearchNode>& nodes = context.nodes;
+    const int cost = nodes[context.finishIndex].startCost;
+    long long lowest = cost;
+
+    auto consider = [&](int i) {
+        lowest = (std::min)(lowest, static_cast<long long>(nodes[i].startCost) + estimate(context, i));
+    };
+    for (int i : context.openTiles.tiles())
+        consider(i);
+    for (int i : context.inconsistent)
+        consider(i);
+
+    if (lowest <= 0)
+        return 1.0f;
+    return (std::min)(context.heuristicWeight, (std::max)(1.0f, static_cast<float>(cost / static_cast<double>(lowest))));
+}
+
+SearchStatus Pathfinder::beginPath(SearchContext& context, int xStart, int yStart, int xFinish, int yFinish) const
+{
+    bind(context);
+    context.slice = SearchContext::SlicedQuery();
+    if (grid->empty() || !inBounds(xStart, yStart) || hasCollision(context, xFinish, yFinish))
+        return context.slice.status;
+
+    context.slice.start = index(xStart, yStart);
+    context.slice.finish = index(xFinish, yFinish);
+    restartSlice(context);
+    return context.slice.status;
+}
+
+void Pathfinder::restartSlice(SearchContext& context) const
+{
+    SearchContext::SlicedQuery& slice = context.slice;
+    slice.path.clear();
+    if (hasCollision(context, slice.finish % mapWidth, slice.finish / mapWidth)) {
+        slice.status = SearchStatus::NoPath;
+        return;
+    }
+
+    beginSearch(context, fullRegion(), false);
+    context.finishIndex = slice.finish;
+    if (grid->hasUniformWeights())
+        context.jumpTable = grid->getJumpTable(context.entitySize).data();
+    slice.status = SearchStatus::Searching;
+    slice.closest = -1;
+    slice.entitySize = context.entitySize;
+    slice.generation = context.generation;
+    slice.expansions = 0;
+
+    touch(context, slice.start);
+    context.openTiles.push(context.nodes, slice.start);
+}
+
+SearchStatus Pathfinder::continuePath(SearchContext& context, const SearchBudget& budget) const
+{
+    bind(context);
+    SearchContext::SlicedQuery& slice = context.slice;
+    if (slice.status != SearchStatus::Searching)
+        return slice.status;
+
+    // Another query or entity size used the nodes since the last slice
+    if (slice.generation != context.generation || slice.entitySize != context.entitySize) {
+        restartSlice(context);
+        if (slice.status != SearchStatus::Searching)
+            return slice.status;
+    }
+
+    std::vector<SearchNode>& nodes = context.nodes;
+    const bool jumping = grid->hasUniformWeights();
+    const auto started = std::chrono::steady_clock::now();
+    int expanded = 0;
+
+    while (true) {
+        int tile = context.openTiles.pop(nodes);
+        if (tile < 0) {
+            slice.status = SearchStatus::NoPath;
+            break;
+        }
+
+        // Same expansions as newPath, so a finished slice finds the same path
+        bool found;
+        if (jumping) {
+            nodes[tile].closed = true;
+            found = tile == context.finishIndex;
+            if (!found)
+                jumpSuccessors(context, tile);
+        }
+        else {
+            found = turnOver(context, tile);
+        }
+
+        if (slice.closest < 0 || nodes[tile].finishCost < nodes[slice.closest].finishCost ||
+            (nodes[tile].finishCost == nodes[slice.closest].finishCost && nodes[tile].startCost < nodes[slice.closest].startCost))
+            slice.closest = tile;
+        slice.expansions++;
+
+        if (found) {
+            slice.status = SearchStatus::Found;
+            slice.path = backtrackPath(context, tile);
+            context.xStart = slice.start % mapWidth;
+            context.yStart = slice.start / mapWidth;
+            context.xFinish = slice.finish % mapWidth;
+            context.yFinish = slice.finish / mapWidth;
+            break;
+        }
+
+        if (budget.maxExpansions > 0 && ++expanded >= budget.maxExpansions)
+            break;
+        // Reading the clock costs about as much as an expansion, so only every 16th
+        if (budget.maxMicroseconds > 0 && (slice.expansions & 15) == 0 &&
+            std::chrono::steady_clock::now() - started >= std::chrono::microseconds(budget.maxMicroseconds))
+            break;
+    }
+    return slice.status;
+}
+
+std::vector<std::shared_ptr<AstarTile>> Pathfinder::partialPath(SearchContext& context) const
+{
+    bind(context);
+    const SearchContext::SlicedQuery& slice = context.slice;
+    if (slice.status == SearchStatus::Found)
+        return slice.path;
+
+    // The parents of a search that lost its nodes are gone
+    if (slice.closest < 0 || slice.generation != context.generation)
+        return {};
+    return smoothRoute(context, backtrackRoute(context, slice.closest));
+}
+
+void Pathfinder::jumpSuccessors(SearchContext& context, int current) const
+{
+    std::vector<SearchNode>& nodes = context.nodes;
+    int x = current % mapWidth;
+    int y = current / mapWidth;
+
+    // Directions worth following, pruned by the direction we arrived from
+    int dirs[8][2];
+    int count = 0;
+    auto add = [&](int dx, int dy) { dirs[count][0] = dx; dirs[count][1] = dy; count++; };
+
+    int parent = nodes[current].parent;
+    if (parent < 0) {
+        for (int dy = -1; dy <= 1; ++dy) {
+            for (int dx = -1; dx <= 1; ++dx) {
+                if (dx == 0 && dy == 0)
+                    continue;
+                if (dx != 0 && dy != 0 && (!walkable(context, x + dx, y) || !walkable(context, x, y + dy)))
+                    continue;
+                add(dx, dy);
+            }
+        }
+    }
+    else {
+        int dx = x - parent % mapWidth;
+        int dy = y - parent / mapWidth;
+        dx = (dx > 0) - (dx < 0);
+        dy = (dy > 0) - (dy < 0);
+
+        if (dx != 0 && dy != 0) {
+            bool vertical = walkable(context, x, y + dy);
+            bool horizontal = walkable(context, x + dx, y);
+            if (vertical)
+                add(0, dy);
+            if (horizontal)
+                add(dx, 0);
+            if (vertical && horizontal)
+                add(dx, dy);
+        }
+        else if (dx != 0) {
+            bool next = walkable(context, x + dx, y);
+            bool up = walkable(context, x, y - 1);
+            bool down = walkable(context, x, y + 1);
+            if (next) {
+                add(dx, 0);
+                if (up)
+                    add(dx, -1);
+                if (down)
+                    add(dx, 1);
+            }
+            if (up)
+                add(0, -1);
+            if (down)
+                add(0, 1);
+        }
+        else {
+            bool next = walkable(context, x, y + dy);
+            bool left = walkable(context, x - 1, y);
+            bool right = walkable(context, x + 1, y);
+            if (next) {
+                add(0, dy);
+                if (left)
+                    add(-1, dy);
+                if (right)
+                    add(1, dy);
+            }
+            if (left)
+                add(-1, 0);
+            if (right)
+                add(1, 0);
+        }
+    }
+
+    for (int d = 0; d < count; ++d) {
+        int dx = dirs[d][0];
+        int dy = dirs[d][1];
+        int jumpPoint = (dx != 0 && dy != 0)
+            ? jump(context, x + dx, y + dy, dx, dy)
+            : jumpStraight(context, x, y, dx, dy);
+        if (jumpPoint < 0)
+            continue;
+
+        SearchNode& t = touch(context, jumpPoint);
+        if (t.closed)
+            continue;
+
+        int newCost = nodes[current].startCost +
+            phyt(jumpPoint % mapWidth, jumpPoint / mapWidth, x, y);
+
+        bool contains = t.isOpen();
+
+        if (!contains || t.startCost > newCost) {
+            t.startCost = newCost;
+            t.totalCost = t.startCost + t.finishCost;
+            t.parent = current;
+        }
+
+        if (!contains)
+            context.openTiles.push(nodes, jumpPoint);
+        else
+            context.openTiles.decrease(nodes, jumpPoint);
+    }
+}
+
+// Walks diagonally from (x, y) until it finds a tile from which a straight
+// jump reaches a jump point, or the finish. Diagonal steps keep the
+// no-corner-cutting rule of diagonalDir: both orthogonal tiles have to be free.
+int Pathfinder::jump(SearchContext& context, int x, int y, int dx, int dy) const
+{
+    while (true) {
+        if (!walkable(context, x, y))
+            return -1;
+
+        int i = index(x, y);
+        if (i == context.finishIndex)
+            return i;
+
+        if (jumpStraight(context, x, y, dx, 0) >= 0 || jumpStraight(context, x, y, 0, dy) >= 0)
+            return i;
+
+        if (!walkable(context, x + dx, y) || !walkable(context, x, y + dy))
+            return -1;
+
+        x += dx;
+        y += dy;
+    }
+}
+
+// Straight jump starting next to (x, y), answered from the precomputed table.
+int Pathfinder::jumpStraight(SearchContext& context, int x, int y, int dx, int dy) const
+{
+    int dir = dx > 0 ? 0 : dx < 0 ? 1 : dy > 0 ? 2 : 3;
+    int distance = context.jumpTable[index(x, y) * 4 + dir];
+    int reach = distance > 0 ? distance : -distance;
+
+    int xFinishOffset = context.finishIndex % mapWidth - x;
+    int yFinishOffset = context.finishIndex / mapWidth - y;
+    int steps = dx != 0 ? xFinishOffset * dx : yFinishOffset * dy;
+    bool onLine = dx != 0 ? yFinishOffset == 0 : xFinishOffset == 0;
+    if (onLine && steps > 0 && steps <= reach)
+        return context.finishIndex;
+
+    if (distance > 0)
+        return index(x + dx * distance, y + dy * distance);
+    return -1;
+}
+
+void Pathfinder::beginSearch(SearchContext& context, const Region& region, bool reverse) const
+{
+    context.region = region;
+    context.reverse = reverse;
+    context.heuristicWeight = 1.0f;
+    context.landmarks = landmarks && (landmarks->covers(*grid, context.entitySize) ||
+        (staticLayer && landmarks->covers(*staticLayer, context.entitySize))) ? landmarks.get() : nullptr;
+    context.openTiles.clear();
+
+    // Contexts get their node storage from the first map they search
+    const size_t count = static_cast<size_t>(mapWidth) * mapHeight;
+    if (context.nodes.size() != count) {
+        context.nodes.assign(count, SearchNode());
+        context.backwardNodes.clear();
+        context.generation = 0;
+    }
+
+    // Stamps wrapped around: every node has to be invalidated explicitly
+    if (++context.generation == 0) {
+        for (auto& n : context.nodes)
+            n.generation = 0;
+        for (auto& n : context.backwardNodes)
+            n.generation = 0;
+        context.generation = 1;
+    }
+}
+
+SearchNode& Pathfinder::touch(SearchContext& context, int index) const
+{
+    SearchNode& n = context.nodes[index];
+    if (n.generation != context.generation) {
+        n = SearchNode();
+        n.generation = context.generation;
+        if (context.finishIndex >= 0)
+            n.finishCost = static_cast<int>(estimate(context, index) * context.heuristicWeight);
+        n.totalCost = n.finishCost;
+    }
+    return n;
+}
+
+// Uninflated estimate of the cost from a tile to the finish: the octile
+// distance, raised to the landmark bound where that is larger
+int Pathfinder::estimate(const SearchContext& context, int index) const
+{
+    const int finish = context.finishIndex;
+    int h = phyt(finish % mapWidth, finish / mapWidth, index % mapWidth, index / mapWidth);
+    if (context.landmarks)
+        h = (std::max)(h, context.landmarks->lowerBound(index, finish));
+    return h;
+}
+
+bool Pathfinder::turnOver(SearchContext& context, int current) const
+{
+    std::vector<SearchNode>& nodes = context.nodes;
+    int x1 = current % mapWidth;
+    int y1 = current / mapWidth;
+
+    for (int y = y1 - 1; y <= y1 + 1; ++y) {
+        for (int x = x1 - 1; x <= x1 + 1; ++x) {
+
+            if (!context.region.contains(x, y))
+                continue;
+
+            int i = index(x, y);
+            if (grid->clearanceAt(i) < context.entitySize)
+                continue;
+
+            SearchNode& t = touch(context, i);
+
+            if (i == current) {
+                t.closed = true;
+                if (i == context.finishIndex)
+                    return true;
+            }
+
+            if (!t.closed &&
+                diagonalDir(context, x1, y1, x, y))
+            {
+                // Reverse searches pay for the step into the current tile
+                int moveCost = phyt(x, y, x1, y1) * grid->weightAt(context.reverse ? current : i);
+                int newCost = moveCost + nodes[current].startCost;
+
+                bool contains = t.isOpen();
+
+                if (!contains || t.startCost > newCost) {
+                    t.startCost = newCost;
+                    t.totalCost = t.startCost + t.finishCost;
+                    t.parent = current;
+                }
+
+                if (!contains)
+                    context.openTiles.push(nodes, i);
+                else
+                    context.openTiles.decrease(nodes, i);
+            }
+        }
+    }
+    return false;
+}
+
+bool Pathfinder::diagonalDir(const SearchContext& context, int xParent, int yParent, int xNext, int yNext) const
+{
+    int dx = xParent - xNext;
+    int dy = yParent - yNext;
+
+    if (dx != 0 && dy != 0) {
+        if ((inBounds(xNext + dx, yNext) && grid->clearanceAt(index(xNext + dx, yNext)) < context.entitySize) ||
+            (inBounds(xNext, yNext + dy) && grid->clearanceAt(index(xNext, yNext + dy)) < context.entitySize))
+            return false;
+    }
+    return true;
+}
+
+std::vector<std::shared_ptr<AstarTile>>
+Pathfinder::backtrackPath(SearchContext& context, int finishIndex) const
+{
+    context.path = smoothRoute(context, backtrackRoute(context, finishIndex));
+    return context.path;
+}
+
+std::vector<int> Pathfinder::backtrackRoute(const SearchContext& context, int finishIndex) const
+{
+    std::vector<int> route;
+    for (int t = finishIndex; t >= 0; t = context.nodes[t].parent)
+        route.push_back(t);
+
+    std::reverse(route.begin(), route.end());
+    return route;
+}
+
+std::vector<std::shared_ptr<AstarTile>>
+Pathfinder::smoothRoute(const SearchContext& context, std::vector<int> route) const
+{
+    if (route.size() >= 3) {
+        // 1) remove collinear points
+        std::vector<int> filtered;
+        filtered.push_back(route[0]);
+
+        for (size_t i = 1; i + 1 < route.size(); ++i) {
+            if (!isCollinear(filtered.back(), route[i], route[i + 1]))
+                filtered.push_back(route[i]);
+        }
+        filtered.push_back(route.back());
+
+        // 2) line-of-sight pruning
+        std::vector<int> optimized;
+        optimized.push_back(filtered[0]);
+
+        size_t anchor = 0;
+        for (size_t i = 2; i < filtered.size(); ++i) {
+            if (!hasLineOfSight(context, filtered[anchor], filtered[i])) {
+                optimized.push_back(filtered[i - 1]);
+                anchor = i - 1;
+            }
+        }
+        optimized.push_back(filtered.back());
+
+        route = std::move(optimized);
+    }
+
+    std::vector<std::shared_ptr<AstarTile>> smoothed;
+    for (int t : route)
+        smoothed.push_back(std::make_shared<AstarTile>(t % mapWidth, t / mapWidth, false, grid->weightAt(t)));
+    return smoothed;
+}
+
+
+int Pathfinder::phyt(int xStart, int yStart, int xPos, int yPos)
+{
+    int dx = std::abs(xStart - xPos);
+    int dy = std::abs(yStart - yPos);
+
+    int diagonal = (std::min)(dx, dy);
+    return diagonal * 14 + (dx - diagonal) * 10 + (dy - diagonal) * 10;
+}
+
+int Pathfinder::euclid(int xStart, int yStart, int xPos, int yPos)
+{
+    double dx = xStart - xPos;
+    double dy = yStart - yPos;
+    return static_cast<int>(std::lround(std::sqrt(dx * dx + dy * dy) * 10.0));
+}
+
+bool Pathfinder::hasCollision(const SearchContext& context, int x, int y) const
+{
+    if (!inBounds(x, y) || grid->empty())
+        return true;
+
+    return grid->clearanceAt(index(x, y)) < context.entitySize;
+}
+
+// Bresenham line between two tile centres. The tiles it visits in one row
+// (one column for steep lines) form a contiguous span whose length follows
+// from the error term, so the line is tested a span at a time, one word per
+// 64 tiles, instead of tile by tile.
+bool Pathfinder::hasLineOfSight(const SearchContext& context, int from, int to) const
+{
+    const OccupancyGrid& rows = grid->getBlockedRows(context.entitySize);
+    const OccupancyGrid& columns = grid->getBlockedColumns(context.entitySize);
+
+    int x0 = from % mapWidth;
+    int y0 = from / mapWidth;
+    int x1 = to % mapWidth;
+    int y1 = to / mapWidth;
+
+    int dx = std::abs(x1 - x0);
+    int dy = std::abs(y1 - y0);
+    int sx = (x0 < x1) ? 1 : -1;
+    int sy = (y0 < y1) ? 1 : -1;
+    int err = dx - dy;
+
+    if (dx >= dy) {
+        while (y0 != y1) {
+            // Steps that only move in x, taken while 2 * err >= dx
+            int spanStart = x0;
+            int e2 = 2 * err;
+            if (e2 >= dx) {
+                int steps = (e2 - dx) / (2 * dy) + 1;
+                x0 += steps * sx;
+                err -= steps * dy;
+            }
+
+            if (!rows.isSpanFree(y0, (std::min)(spanStart, x0), (std::max)(spanStart, x0)))
+                return false;
+
+            // Into the next row, diagonally when x moves as well
+            e2 = 2 * err;
+            if (e2 > -dy) { err -= dy; x0 += sx; }
+            err += dx;
+            y0 += sy;
+        }
+        return rows.isSpanFree(y0, (std::min)(x0, x1), (std::max)(x0, x1));
+    }
+
+    while (x0 != x1) {
+        // Steps that only move in y, taken while 2 * err <= -dy
+        int spanStart = y0;
+        int e2 = 2 * err;
+        if (e2 <= -dy) {
+            int steps = (-dy - e2) / (2 * dx) + 1;
+            y0 += steps * sy;
+            err += steps * dx;
+        }
+
+        if (!columns.isSpanFree(x0, (std::min)(spanStart, y0), (std::max)(spanStart, y0)))
+            return false;
+
+        // Into the next column, diagonally when y moves as well
+        e2 = 2 * err;
+        err -= dy;
+        x0 += sx;
+        if (e2 < dx) { err += dx; y0 += sy; }
+    }
+    return columns.isSpanFree(x0, (std::min)(y0, y1), (std::max)(y0, y1));
+}
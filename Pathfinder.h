@@ -1,51 +1,168 @@
-#pragma once
-#include "AstarTile.h"
-#include <vector>
-#include <memory>
-
-class Pathfinder {
-private:
-    std::vector<std::vector<std::shared_ptr<AstarTile>>> tiles;
-    bool first = true;
-    int xFinish = 0;
-    int yFinish = 0;
-    int xStart = 0;
-    int yStart = 0;
-    int mapHeight;
-    int mapWidth;
-    int entityWidth;
-    int entityHeight;
-    std::vector<std::shared_ptr<AstarTile>> path;
-    std::vector<std::vector<std::shared_ptr<AstarTile>>> aTiles;
-    std::vector<std::shared_ptr<AstarTile>> markedATiles;
-
-    std::vector<std::shared_ptr<AstarTile>> searchTiles();
-    std::shared_ptr<AstarTile> closestFinish(int lowestScore);
-    int findLowestScore();
-    bool turnOver(std::shared_ptr<AstarTile>& tile);
-    bool diagonalDir(int xParent, int yParent, int xNext, int yNext);
-    std::shared_ptr<AstarTile> getTile(int x, int y);
-    std::vector<std::shared_ptr<AstarTile>> backtrackPath(std::shared_ptr<AstarTile>& finishTile);
-    int phyt(int xStart, int yStart, int xPos, int yPos);
-    bool hasCollision(int x, int y);
-    bool hasLineOfSight(const AstarTile& from, const AstarTile& to);
-    static bool isCollinear(
-        const AstarTile& a,
-        const AstarTile& b,
-        const AstarTile& c)
-    {
-        int dx1 = b.getX() - a.getX();
-        int dy1 = b.getY() - a.getY();
-        int dx2 = c.getX() - b.getX();
-        int dy2 = c.getY() - b.getY();
-
-        return dx1 * dy2 == dy1 * dx2;
-    }
-
-public:
-    Pathfinder(int mapWidth, int mapHeight, int entityWidth, int entityHeight);
-    ~Pathfinder() = default;
-
-    void setTileMap(const std::vector<std::vector<std::shared_ptr<AstarTile>>>& tileMap) { tiles = tileMap;  }
-    std::vector<std::shared_ptr<AstarTile>> newPath(int xStart, int yStart, int xFinish, int yFinish);
-};
\ No newline at end of file
+#pragma once
+#include "AstarTile.h"
+#include "SearchNode.h"
+#include "OpenList.h"
+#include "OccupancyGrid.h"
+#include "NavGrid.h"
+#include "SearchContext.h"
+#include "LandmarkTable.h"
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <atomic>
+
+// A* and jump point search over a shared NavGrid. Every query takes the
+// SearchContext it writes to; the const overloads only read the grid, so one
+// Pathfinder can serve any number of threads as long as each brings its own
+// context. The overloads without a context use the Pathfinder's own.
+class Pathfinder {
+public:
+    using Region = SearchRegion;
+
+    static constexpr int maxEntitySize = NavGrid::maxEntitySize;
+
+private:
+    int mapHeight;
+    int mapWidth;
+    std::shared_ptr<const NavGrid> grid;
+    std::shared_ptr<const LandmarkTable> landmarks;
+    std::shared_ptr<const NavGrid> staticLayer; // grid the current one only adds obstacles to, may be null
+    SearchContext context;
+
+    std::vector<std::shared_ptr<AstarTile>> searchTiles(SearchContext& context) const;
+    std::vector<std::shared_ptr<AstarTile>> searchJumps(SearchContext& context) const;
+    std::vector<std::shared_ptr<AstarTile>> searchBidirectional(SearchContext& context) const;
+    std::vector<std::shared_ptr<AstarTile>> searchTheta(SearchContext& context) const;
+    void settleTheta(SearchContext& context, int current) const;
+    std::vector<std::shared_ptr<AstarTile>> searchAnytime(SearchContext& context) const;
+    SearchStatus improveAnytime(SearchContext& context, int& expansionsLeft, std::chrono::steady_clock::time_point deadline) const;
+    void reweightAnytime(SearchContext& context, float weight) const;
+    float anytimeBound(const SearchContext& context) const;
+    int bidirectionalRoute(SearchContext& context, int start, int finish, std::vector<int>& route) const;
+    void expandSide(SearchContext& context, bool backward, int current, int start, int finish, int& best, int& meet) const;
+    SearchNode& touchSide(SearchContext& context, bool backward, int index, int start, int finish) const;
+    void loadMap(const OccupancyGrid& occupancy, std::vector<int> weights);
+    void useGrid(std::shared_ptr<const NavGrid> grid);
+    void bind(SearchContext& context) const;
+    void jumpSuccessors(SearchContext& context, int current) const;
+    int jump(SearchContext& context, int x, int y, int dx, int dy) const;
+    int jumpStraight(SearchContext& context, int x, int y, int dx, int dy) const;
+    void beginSearch(SearchContext& context, const Region& region, bool reverse) const;
+    void restartSlice(SearchContext& context) const;
+    int runSearch(SearchContext& context, int start) const;
+    SearchNode& touch(SearchContext& context, int index) const;
+    int estimate(const SearchContext& context, int index) const;
+    bool turnOver(SearchContext& context, int index) const;
+    bool diagonalDir(const SearchContext& context, int xParent, int yParent, int xNext, int yNext) const;
+    std::vector<std::shared_ptr<AstarTile>> backtrackPath(SearchContext& context, int finishIndex) const;
+    std::vector<int> backtrackRoute(const SearchContext& context, int finishIndex) const;
+    bool hasCollision(const SearchContext& context, int x, int y) const;
+    bool hasLineOfSight(const SearchContext& context, int from, int to) const;
+    bool isCollinear(int a, int b, int c) const
+    {
+        int dx1 = b % mapWidth - a % mapWidth;
+        int dy1 = b / mapWidth - a / mapWidth;
+        int dx2 = c % mapWidth - b % mapWidth;
+        int dy2 = c / mapWidth - b / mapWidth;
+
+        return dx1 * dy2 == dy1 * dx2;
+    }
+    int index(int x, int y) const { return y * mapWidth + x; }
+    bool inBounds(int x, int y) const { return x >= 0 && x < mapWidth && y >= 0 && y < mapHeight; }
+    bool walkable(const SearchContext& context, int x, int y) const
+    {
+        return inBounds(x, y) && grid->clearanceAt(index(x, y)) >= context.entitySize;
+    }
+
+public:
+    Pathfinder(int mapWidth, int mapHeight, int entitySize = 1);
+    // Search a map built elsewhere, sharing it with every other Pathfinder on it
+    explicit Pathfinder(std::shared_ptr<const NavGrid> grid, int entitySize = 1);
+    ~Pathfinder() = default;
+
+    // Both replace the grid of this Pathfinder only; others sharing the old one keep it
+    void setTileMap(const std::vector<std::vector<std::shared_ptr<AstarTile>>>& tileMap);
+    // Adopt a bit-packed map in which every free tile costs 1
+    void setOccupancy(const OccupancyGrid& grid);
+    // Adopt a map that differs from the current one only at changedTiles (y * width + x);
+    // clearance is recomputed near those tiles only, tile weights are kept
+    void updateOccupancy(const OccupancyGrid& occupancy, const std::vector<int>& changedTiles);
+    const std::shared_ptr<const NavGrid>& getGrid() const { return grid; }
+    // Sharpen the A* heuristic with ALT bounds; only used while the table
+    // covers the grid (or its static layer) and the entity size being searched
+    void setLandmarks(std::shared_ptr<const LandmarkTable> landmarks) { this->landmarks = std::move(landmarks); }
+    const std::shared_ptr<const LandmarkTable>& getLandmarks() const { return landmarks; }
+    // Grid whose blocked tiles are all blocked in the current one too, e.g. the
+    // static level geometry under moving props. Costs on it are lower bounds on
+    // this map, so a landmark table built for it stays valid while the rest of
+    // the map changes. Kept across setOccupancy and updateOccupancy: the caller
+    // clears it once the map stops covering it.
+    void setStaticLayer(std::shared_ptr<const NavGrid> layer) { staticLayer = std::move(layer); }
+    const std::shared_ptr<const NavGrid>& getStaticLayer() const { return staticLayer; }
+
+    std::vector<std::shared_ptr<AstarTile>> newPath(int xStart, int yStart, int xFinish, int yFinish, const SearchOptions& options = SearchOptions())
+    {
+        return newPath(context, xStart, yStart, xFinish, yFinish, options);
+    }
+    std::vector<std::shared_ptr<AstarTile>> newPath(SearchContext& context, int xStart, int yStart, int xFinish, int yFinish,
+        const SearchOptions& options = SearchOptions()) const;
+
+    int getMapWidth() const { return mapWidth; }
+    int getMapHeight() const { return mapHeight; }
+    // Size in tiles of the square entity queries without a context are for.
+    // Tiles are the top-left corner of its footprint.
+    void setEntitySize(int entitySize) { context.setEntitySize(entitySize); }
+    int getEntitySize() const { return context.getEntitySize(); }
+    float getPathBound() const { return context.getPathBound(); }
+    bool isWalkable(int x, int y) const { return isWalkable(x, y, context.getEntitySize()); }
+    bool isWalkable(int x, int y, int entitySize) const { return grid->isWalkable(x, y, entitySize); }
+    int getWeight(int x, int y) const { return grid->weightAt(index(x, y)); }
+    bool hasUniformWeights() const { return grid->hasUniformWeights(); }
+    Region fullRegion() const { return Region{ 0, 0, mapWidth - 1, mapHeight - 1 }; }
+
+    // Octile distance in path cost units (10 straight, 14 diagonal)
+    static int phyt(int xStart, int yStart, int xPos, int yPos);
+    // Straight-line distance in the same units, rounded
+    static int euclid(int xStart, int yStart, int xPos, int yPos);
+
+    // A* limited to a region; returns the path cost or -1, and the raw tile route.
+    int searchRegion(int xStart, int yStart, int xFinish, int yFinish, const Region& region, std::vector<int>* route = nullptr)
+    {
+        return searchRegion(context, xStart, yStart, xFinish, yFinish, region, route);
+    }
+    int searchRegion(SearchContext& context, int xStart, int yStart, int xFinish, int yFinish, const Region& region, std::vector<int>* route = nullptr) const;
+    // Dijkstra from a source over a region. In reverse mode the costs are those
+    // of moving from each tile to the source. Read the results with costTo().
+    // Once cancel is set the flood stops early and leaves the costs incomplete.
+    void floodRegion(int xSource, int ySource, const Region& region, bool reverse)
+    {
+        floodRegion(context, xSource, ySource, region, reverse);
+    }
+    void floodRegion(SearchContext& context, int xSource, int ySource, const Region& region, bool reverse,
+        const std::atomic<bool>* cancel = nullptr) const;
+    int costTo(int x, int y) const { return costTo(context, x, y); }
+    int costTo(const SearchContext& context, int x, int y) const;
+    int parentOf(int x, int y) const { return parentOf(context, x, y); }
+    int parentOf(const SearchContext& context, int x, int y) const;
+
+    // Time-sliced search. beginPath sets a query up and every continuePath call
+    // expands it until the finish is reached or the budget is spent; the open
+    // and closed sets are kept in the context in between. Any other query on
+    // the same context takes the nodes over, the next continuePath then starts again.
+    SearchStatus beginPath(int xStart, int yStart, int xFinish, int yFinish)
+    {
+        return beginPath(context, xStart, yStart, xFinish, yFinish);
+    }
+    SearchStatus beginPath(SearchContext& context, int xStart, int yStart, int xFinish, int yFinish) const;
+    SearchStatus continuePath(const SearchBudget& budget) { return continuePath(context, budget); }
+    SearchStatus continuePath(SearchContext& context, const SearchBudget& budget) const;
+    SearchStatus getSliceStatus() const { return context.getSliceStatus(); }
+    int getSliceExpansions() const { return context.getSliceExpansions(); }
+    // The path once Found, before that the route to the closed tile nearest the finish
+    std::vector<std::shared_ptr<AstarTile>> partialPath() { return partialPath(context); }
+    std::vector<std::shared_ptr<AstarTile>> partialPath(SearchContext& context) const;
+
+    // Collinear removal and line-of-sight pruning of a raw tile route
+    std::vector<std::shared_ptr<AstarTile>> smoothRoute(std::vector<int> route) const { return smoothRoute(context, std::move(route)); }
+    std::vector<std::shared_ptr<AstarTile>> smoothRoute(const SearchContext& context, std::vector<int> route) const;
+};
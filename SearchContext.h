@@ -0,0 +1,138 @@
+#pragma once
+#include "AstarTile.h"
+#include "SearchNode.h"
+#include "OpenList.h"
+#include "NavGrid.h"
+#include <vector>
+#include <memory>
+#include <algorithm>
+
+class LandmarkTable;
+
+// Inclusive tile rectangle a search may expand into
+struct SearchRegion {
+    int minX = 0;
+    int minY = 0;
+    int maxX = -1;
+    int maxY = -1;
+
+    bool contains(int x, int y) const { return x >= minX && x <= maxX && y >= minY && y <= maxY; }
+};
+
+// Work one continuePath call may do; a limit of 0 is no limit
+struct SearchBudget {
+    int maxExpansions = 0;
+    int maxMicroseconds = 0;
+};
+
+enum class SearchStatus { Searching, Found, NoPath };
+
+enum class SearchMode {
+    Auto,          // jump point search on uniform-cost maps, A* otherwise
+    AStar,
+    Bidirectional, // A* from both ends, joined where the two frontiers meet
+    LazyTheta,     // any-angle: parents are taken over along lines of sight during the search
+    Anytime,       // ARA*: a quick weighted path first, improved while the budget lasts
+};
+
+// Per-query choices. The defaults find the shortest path the fastest way the map allows.
+struct SearchOptions {
+    SearchMode mode = SearchMode::Auto;
+    // Heuristic weight of Auto, AStar and Anytime searches (f = g + weight * h).
+    // Above 1 paths may cost up to weight times the optimum, for far fewer expansions.
+    float weight = 1.0f;
+    // Anytime only: how far the weight drops per improved path, and the work
+    // allowed after the first one. Without a limit it runs until the path is optimal.
+    float weightStep = 0.5f;
+    SearchBudget budget;
+
+    bool operator==(const SearchOptions& other) const
+    {
+        return mode == other.mode && weight == other.weight && weightStep == other.weightStep &&
+            budget.maxExpansions == other.budget.maxExpansions && budget.maxMicroseconds == other.budget.maxMicroseconds;
+    }
+    bool operator!=(const SearchOptions& other) const { return !(*this == other); }
+};
+
+// Everything one query writes while it runs. The map lives in a shared NavGrid,
+// so a thread only needs its own context to search concurrently with others.
+// Node storage is sized to the map on first use.
+class SearchContext {
+    friend class Pathfinder;
+
+private:
+    int entitySize = 1;
+
+    // Last query and its path, handed out again while the query repeats
+    unsigned gridSerial = 0;
+    int xStart = -1;
+    int yStart = -1;
+    int xFinish = -1;
+    int yFinish = -1;
+    SearchOptions options;
+    std::vector<std::shared_ptr<AstarTile>> path;
+    float bound = 0.0f;
+
+    // Search data, valid per generation
+    std::vector<SearchNode> nodes;
+    unsigned generation = 0;
+    int finishIndex = -1;
+    SearchRegion region;
+    bool reverse = false;
+    OpenList openTiles;
+    const int* jumpTable = nullptr; // table of the grid and entity size being searched
+    float heuristicWeight = 1.0f;
+    const LandmarkTable* landmarks = nullptr; // ALT bounds for this grid and entity size, if any
+
+    // Anytime search: tiles expanded in the current pass, and expanded tiles
+    // whose cost dropped afterwards, reopened by the next pass
+    std::vector<int> expanded;
+    std::vector<int> inconsistent;
+
+    // Second half of a bidirectional search, stamped with the same generation
+    std::vector<SearchNode> backwardNodes;
+    OpenList backwardOpen;
+
+    // Query advanced by continuePath, valid while its search owns the nodes
+    struct SlicedQuery {
+        SearchStatus status = SearchStatus::NoPath;
+        int start = -1;
+        int finish = -1;
+        int closest = -1; // closed tile nearest the finish
+        int entitySize = 0;
+        unsigned generation = 0;
+        int expansions = 0;
+        std::vector<std::shared_ptr<AstarTile>> path;
+    };
+    SlicedQuery slice;
+
+    void forgetQuery()
+    {
+        xStart = yStart = xFinish = yFinish = -1;
+        path.clear();
+        bound = 0.0f;
+    }
+
+public:
+    explicit SearchContext(int entitySize = 1) { setEntitySize(entitySize); }
+
+    // Size in tiles of the square entity later queries are for
+    void setEntitySize(int entitySize)
+    {
+        entitySize = (std::max)(1, (std::min)(entitySize, NavGrid::maxEntitySize));
+        if (entitySize == this->entitySize)
+            return;
+
+        this->entitySize = entitySize;
+        forgetQuery();
+    }
+    int getEntitySize() const { return entitySize; }
+
+    // How many times the optimal cost the last path found by newPath costs at
+    // most: 1 for the exact modes, 0 without a path or for LazyTheta, which
+    // gives no guarantee.
+    float getPathBound() const { return bound; }
+
+    SearchStatus getSliceStatus() const { return slice.status; }
+    int getSliceExpansions() const { return slice.expansions; }
+};
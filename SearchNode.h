@@ -0,0 +1,17 @@
+#pragma once
+
+// Per-tile A* state, stored flat and indexed by y * mapWidth + x.
+// A node only holds valid data for the search whose generation it carries;
+// stale nodes are reset on first touch, so starting a search costs O(1).
+struct SearchNode {
+    int startCost = 0;
+    int finishCost = 0;
+    int totalCost = 0;
+    int parent = -1;
+    int openIndex = -1;
+    int openOrder = 0;
+    unsigned generation = 0;
+    bool closed = false;
+
+    bool isOpen() const { return openIndex >= 0; }
+};
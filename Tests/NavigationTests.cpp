@@ -0,0 +1,241 @@
+// Checks that the incremental map updates agree with building from scratch, and
+// that the incremental planner agrees with A*. Maps and edits are random but
+// seeded, so a failure repeats. Build it together with the engine's navigation
+// sources; it prints each failure and exits with 1 when any check failed.
+#include "../Headers/NavGrid.h"
+#include "../Headers/ComponentLabels.h"
+#include "../Headers/HierarchicalMap.h"
+#include "../Headers/DStarLite.h"
+#include "../Headers/OccupancyGrid.h"
+#include "../Headers/Pathfinder.h"
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <set>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+    int failures = 0;
+
+    void check(bool passed, const char* test, int trial, int step, const char* what)
+    {
+        if (passed)
+            return;
+        ++failures;
+        std::printf("FAIL %s: trial %d step %d, %s\n", test, trial, step, what);
+    }
+
+    OccupancyGrid randomOccupancy(int width, int height, int density, std::mt19937& rng)
+    {
+        OccupancyGrid occupancy(width, height);
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                if (static_cast<int>(rng() % 100) < density)
+                    occupancy.setBlocked(x, y, true);
+            }
+        }
+        return occupancy;
+    }
+
+    // Blocks or clears a small random rectangle, as a moving collider would,
+    // and returns the tiles whose occupancy changed
+    std::vector<int> editOccupancy(OccupancyGrid& occupancy, std::mt19937& rng)
+    {
+        const int width = occupancy.getWidth();
+        const int height = occupancy.getHeight();
+        const int minX = rng() % width;
+        const int minY = rng() % height;
+        const int maxX = (std::min)(width - 1, minX + static_cast<int>(rng() % 6));
+        const int maxY = (std::min)(height - 1, minY + static_cast<int>(rng() % 6));
+        OccupancyGrid next = occupancy;
+        next.fillRect(minX, minY, maxX, maxY, rng() % 2 == 0);
+
+        std::vector<int> changedTiles;
+        occupancy.collectChanges(next, changedTiles);
+        occupancy = next;
+        return changedTiles;
+    }
+
+    // Labels may be numbered differently, the regions they mark must be the same
+    bool sameRegions(const std::vector<int>& a, const std::vector<int>& b)
+    {
+        if (a.size() != b.size())
+            return false;
+        std::unordered_map<int, int> aToB;
+        std::unordered_map<int, int> bToA;
+        for (size_t i = 0; i < a.size(); ++i) {
+            if ((a[i] < 0) != (b[i] < 0))
+                return false;
+            if (a[i] < 0)
+                continue;
+            if (aToB.emplace(a[i], b[i]).first->second != b[i] || bToA.emplace(b[i], a[i]).first->second != a[i])
+                return false;
+        }
+        return true;
+    }
+
+    // Nodes by position and edges by the positions they join, independent of node order
+    std::set<std::tuple<int, int, int, int, int>> graphOf(const HierarchicalMap& hierarchy)
+    {
+        std::vector<int> nodeData;
+        std::vector<int> edgeData;
+        hierarchy.saveGraph(nodeData, edgeData);
+
+        std::set<std::tuple<int, int, int, int, int>> graph;
+        size_t edge = 0;
+        for (size_t node = 0; node < nodeData.size(); node += 3) {
+            graph.insert(std::make_tuple(nodeData[node], nodeData[node + 1], -1, -1, -1));
+            for (int i = 0; i < nodeData[node + 2]; ++i, edge += 2) {
+                const size_t to = static_cast<size_t>(edgeData[edge]) * 3;
+                graph.insert(std::make_tuple(nodeData[node], nodeData[node + 1], nodeData[to], nodeData[to + 1], edgeData[edge + 1]));
+            }
+        }
+        return graph;
+    }
+
+    int routeCost(const Pathfinder& pathfinder, const std::vector<int>& route)
+    {
+        const int width = pathfinder.getMapWidth();
+        int cost = 0;
+        for (size_t i = 1; i < route.size(); ++i) {
+            const int x = route[i] % width;
+            const int y = route[i] / width;
+            cost += Pathfinder::phyt(route[i - 1] % width, route[i - 1] / width, x, y) * pathfinder.getWeight(x, y);
+        }
+        return cost;
+    }
+
+    void testNavGridUpdate()
+    {
+        std::mt19937 rng(1);
+        for (int trial = 0; trial < 20; ++trial) {
+            OccupancyGrid occupancy = randomOccupancy(20 + rng() % 150, 20 + rng() % 150, rng() % 35, rng);
+            auto grid = std::make_shared<const NavGrid>(occupancy, std::vector<int>());
+            for (int step = 0; step < 20; ++step) {
+                // Tables the previous grid has built are repaired rather than dropped
+                grid->getJumpTable(1);
+                grid->getJumpTable(2);
+                grid->getBlockedRows(1);
+                grid->getBlockedColumns(2);
+
+                const std::vector<int> changedTiles = editOccupancy(occupancy, rng);
+                grid = std::make_shared<const NavGrid>(*grid, occupancy, changedTiles);
+                const NavGrid fresh(occupancy, std::vector<int>());
+                check(grid->getClearance() == fresh.getClearance(), "NavGrid update", trial, step, "clearance differs");
+                for (int entitySize = 1; entitySize <= 2; ++entitySize) {
+                    check(grid->getJumpTable(entitySize) == fresh.getJumpTable(entitySize), "NavGrid update", trial, step, "jump table differs");
+                    check(grid->getBlockedRows(entitySize) == fresh.getBlockedRows(entitySize), "NavGrid update", trial, step, "blocked rows differ");
+                    check(grid->getBlockedColumns(entitySize) == fresh.getBlockedColumns(entitySize), "NavGrid update", trial, step,
+                        "blocked columns differ");
+                }
+            }
+        }
+    }
+
+    void testComponentLabelsUpdate()
+    {
+        std::mt19937 rng(2);
+        for (int trial = 0; trial < 20; ++trial) {
+            const int entitySize = 1 + trial % 3;
+            OccupancyGrid occupancy = randomOccupancy(20 + rng() % 150, 20 + rng() % 150, rng() % 45, rng);
+            auto grid = std::make_shared<const NavGrid>(occupancy, std::vector<int>());
+            auto labels = std::make_shared<const ComponentLabels>(*grid, entitySize);
+            for (int step = 0; step < 20; ++step) {
+                const std::vector<int> changedTiles = editOccupancy(occupancy, rng);
+                grid = std::make_shared<const NavGrid>(*grid, occupancy, changedTiles);
+                labels = std::make_shared<const ComponentLabels>(*grid, *labels, changedTiles);
+                const ComponentLabels fresh(*grid, entitySize);
+                check(sameRegions(labels->getLabels(), fresh.getLabels()), "ComponentLabels update", trial, step, "regions differ");
+            }
+        }
+    }
+
+    void testHierarchyUpdate()
+    {
+        std::mt19937 rng(3);
+        for (int trial = 0; trial < 20; ++trial) {
+            const int width = 20 + rng() % 200;
+            const int height = 20 + rng() % 200;
+            const int entitySize = 1 + trial % 3;
+            const int clusterSize = 4 + rng() % 20;
+            OccupancyGrid occupancy = randomOccupancy(width, height, rng() % 30, rng);
+            auto pathfinder = std::make_shared<Pathfinder>(width, height);
+            pathfinder->setOccupancy(occupancy);
+            pathfinder->setEntitySize(entitySize);
+            HierarchicalMap hierarchy(pathfinder, clusterSize);
+            hierarchy.build();
+            for (int step = 0; step < 15; ++step) {
+                const std::vector<int> changedTiles = editOccupancy(occupancy, rng);
+                pathfinder->updateOccupancy(occupancy, changedTiles);
+                hierarchy.update(changedTiles);
+                HierarchicalMap fresh(pathfinder, clusterSize);
+                fresh.build();
+                check(graphOf(hierarchy) == graphOf(fresh), "HierarchicalMap update", trial, step, "abstract graph differs");
+            }
+        }
+    }
+
+    void testDStarLiteMatchesAStar()
+    {
+        std::mt19937 rng(4);
+        for (int trial = 0; trial < 6; ++trial) {
+            const int width = 60 + rng() % 100;
+            const int height = 60 + rng() % 100;
+            const int entitySize = 1 + trial % 2;
+            OccupancyGrid occupancy = randomOccupancy(width, height, 10 + rng() % 20, rng);
+            auto pathfinder = std::make_shared<Pathfinder>(width, height);
+            pathfinder->setOccupancy(occupancy);
+            pathfinder->setEntitySize(entitySize);
+            DStarLite planner(pathfinder, entitySize);
+
+            // The agent walks its path while the target wanders and the map changes now and then
+            int xStart = 2;
+            int yStart = 2;
+            int xFinish = width - 3;
+            int yFinish = height - 3;
+            std::vector<int> route;
+            std::vector<int> searchedRoute;
+            for (int step = 0; step < 150; ++step) {
+                xFinish = (std::max)(0, (std::min)(width - 1, xFinish + static_cast<int>(rng() % 5) - 2));
+                yFinish = (std::max)(0, (std::min)(height - 1, yFinish + static_cast<int>(rng() % 5) - 2));
+                if (step % 10 == 5) {
+                    const std::vector<int> changedTiles = editOccupancy(occupancy, rng);
+                    pathfinder->updateOccupancy(occupancy, changedTiles);
+                    pathfinder->setEntitySize(entitySize);
+                    planner.tilesChanged(changedTiles);
+                }
+
+                const bool planned = planner.plan(xStart, yStart, xFinish, yFinish, route);
+                const int cost = pathfinder->isWalkable(xFinish, yFinish)
+                    ? pathfinder->searchRegion(xStart, yStart, xFinish, yFinish, pathfinder->fullRegion(), &searchedRoute)
+                    : -1;
+                check(planned == (cost >= 0), "D* Lite against A*", trial, step, "reachability differs");
+                if (planned && cost >= 0)
+                    check(routeCost(*pathfinder, route) == cost, "D* Lite against A*", trial, step, "route cost differs");
+
+                if (planned && route.size() > 3) {
+                    xStart = route[2] % width;
+                    yStart = route[2] / width;
+                }
+            }
+        }
+    }
+}
+
+int main()
+{
+    testNavGridUpdate();
+    testComponentLabelsUpdate();
+    testHierarchyUpdate();
+    testDStarLiteMatchesAStar();
+
+    if (failures > 0) {
+        std::printf("%d checks failed\n", failures);
+        return 1;
+    }
+    std::printf("All checks passed\n");
+    return 0;
+}
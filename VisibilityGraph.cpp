@@ -0,0 +1,194 @@
+#include "../Headers/VisibilityGraph.h"
+#include <algorithm>
+#include <cfloat>
+#include <functional>
+#include <queue>
+
+namespace {
+    // Distance the segment tests keep from box edges, so paths may run along them
+    const float edgeTolerance = 1e-3f;
+
+    // Whether the segment passes through the inside of the box (Liang-Barsky clipping)
+    bool crossesBox(const Vector2& a, const Vector2& b, const NavBox& box)
+    {
+        const float dx = b.getX() - a.getX();
+        const float dy = b.getY() - a.getY();
+        const float p[4] = { -dx, dx, -dy, dy };
+        const float q[4] = {
+            a.getX() - (box.minX + edgeTolerance), (box.maxX - edgeTolerance) - a.getX(),
+            a.getY() - (box.minY + edgeTolerance), (box.maxY - edgeTolerance) - a.getY()
+        };
+        float enter = 0.0f;
+        float leave = 1.0f;
+        for (int k = 0; k < 4; ++k) {
+            if (p[k] == 0.0f) {
+                if (q[k] < 0.0f)
+                    return false;
+                continue;
+            }
+            const float t = q[k] / p[k];
+            if (p[k] < 0.0f)
+                enter = (std::max)(enter, t);
+            else
+                leave = (std::min)(leave, t);
+            if (enter >= leave)
+                return false;
+        }
+        return true;
+    }
+}
+
+VisibilityGraph::VisibilityGraph(const std::vector<NavObstacle>& obstacles, float minX, float minY, float maxX, float maxY, float agentRadius)
+    : agentRadius(agentRadius), minX(minX + agentRadius), minY(minY + agentRadius), maxX(maxX - agentRadius), maxY(maxY - agentRadius)
+{
+    boxes.reserve(obstacles.size() * 3);
+    for (const NavObstacle& obstacle : obstacles)
+        coverObstacle(obstacle, agentRadius, boxes);
+
+    // Corners buried in another obstacle or outside the walkable area are never on a path
+    for (const NavBox& box : boxes) {
+        const Corner boxCorners[4] = {
+            { { box.minX, box.minY }, -1, -1 }, { { box.maxX, box.minY }, 1, -1 },
+            { { box.minX, box.maxY }, -1, 1 }, { { box.maxX, box.maxY }, 1, 1 }
+        };
+        for (const Corner& corner : boxCorners) {
+            if (isFree(corner.point))
+                corners.push_back(corner);
+        }
+    }
+
+    const int count = static_cast<int>(corners.size());
+    std::vector<std::vector<Edge>> adjacent(count);
+    for (int a = 0; a < count; ++a) {
+        for (int b = a + 1; b < count; ++b) {
+            const Vector2 direction = corners[b].point - corners[a].point;
+            if (!corners[a].isTangent(direction) || !corners[b].isTangent(direction) ||
+                !isVisible(corners[a].point, corners[b].point))
+                continue;
+            const float cost = direction.length();
+            adjacent[a].push_back({ b, cost });
+            adjacent[b].push_back({ a, cost });
+        }
+    }
+
+    firstEdges.reserve(count + 1);
+    for (const auto& cornerEdges : adjacent) {
+        firstEdges.push_back(static_cast<int>(edges.size()));
+        edges.insert(edges.end(), cornerEdges.begin(), cornerEdges.end());
+    }
+    firstEdges.push_back(static_cast<int>(edges.size()));
+}
+
+bool VisibilityGraph::isFree(const Vector2& point) const
+{
+    if (point.getX() < minX || point.getX() > maxX || point.getY() < minY || point.getY() > maxY)
+        return false;
+    for (const NavBox& box : boxes) {
+        if (point.getX() > box.minX + edgeTolerance && point.getX() < box.maxX - edgeTolerance &&
+            point.getY() > box.minY + edgeTolerance && point.getY() < box.maxY - edgeTolerance)
+            return false;
+    }
+    return true;
+}
+
+// Clamps the point into the walkable area and pushes it out of each box it is in
+// through the nearest side; boxes that overlap may take a few rounds
+Vector2 VisibilityGraph::moveOut(const Vector2& point) const
+{
+    Vector2 moved((std::max)(minX, (std::min)(point.getX(), maxX)), (std::max)(minY, (std::min)(point.getY(), maxY)));
+    for (int round = 0; round < 4 && !isFree(moved); ++round) {
+        for (const NavBox& box : boxes) {
+            const float x = moved.getX();
+            const float y = moved.getY();
+            if (x <= box.minX || x >= box.maxX || y <= box.minY || y >= box.maxY)
+                continue;
+            const float distances[4] = { x - box.minX, box.maxX - x, y - box.minY, box.maxY - y };
+            const int side = static_cast<int>(std::min_element(distances, distances + 4) - distances);
+            moved = side == 0 ? Vector2(box.minX, y) : side == 1 ? Vector2(box.maxX, y)
+                : side == 2 ? Vector2(x, box.minY) : Vector2(x, box.maxY);
+        }
+    }
+    return moved;
+}
+
+bool VisibilityGraph::isVisible(const Vector2& a, const Vector2& b) const
+{
+    for (const NavBox& box : boxes) {
+        if (crossesBox(a, b, box))
+            return false;
+    }
+    return true;
+}
+
+bool VisibilityGraph::findPath(const Vector2& start, const Vector2& finish, std::vector<Vector2>& path) const
+{
+    path.clear();
+    if (minX > maxX || minY > maxY)
+        return false;
+
+    const Vector2 from = moveOut(start);
+    const Vector2 to = moveOut(finish);
+    if (isVisible(from, to)) {
+        path.push_back(from);
+        path.push_back(to);
+        return true;
+    }
+
+    // A* over the corners, the start is node count and the finish is reached
+    // from every corner that sees it
+    typedef std::pair<float, int> Entry;
+    const int count = static_cast<int>(corners.size());
+    std::vector<float> finishCosts(count, -1.0f);
+    for (int c = 0; c < count; ++c) {
+        if (corners[c].isTangent(to - corners[c].point) && isVisible(corners[c].point, to))
+            finishCosts[c] = (to - corners[c].point).length();
+    }
+
+    std::vector<float> costs(count + 1, FLT_MAX);
+    std::vector<int> parents(count + 1, -1);
+    std::vector<char> closed(count + 1, 0);
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+
+    float best = FLT_MAX;
+    int last = -1;
+    auto relax = [&](int parent, int corner, float cost) {
+        if (cost >= costs[corner])
+            return;
+        costs[corner] = cost;
+        parents[corner] = parent;
+        open.push({ cost + (to - corners[corner].point).length(), corner });
+    };
+    for (int c = 0; c < count; ++c) {
+        if (corners[c].isTangent(corners[c].point - from) && isVisible(from, corners[c].point))
+            relax(count, c, (corners[c].point - from).length());
+    }
+
+    while (!open.empty()) {
+        const Entry entry = open.top();
+        open.pop();
+        if (entry.first >= best)
+            break;
+        const int corner = entry.second;
+        if (closed[corner])
+            continue;
+        closed[corner] = 1;
+
+        if (finishCosts[corner] >= 0.0f && costs[corner] + finishCosts[corner] < best) {
+            best = costs[corner] + finishCosts[corner];
+            last = corner;
+        }
+        for (int e = firstEdges[corner]; e < firstEdges[corner + 1]; ++e) {
+            if (!closed[edges[e].to])
+                relax(corner, edges[e].to, costs[corner] + edges[e].cost);
+        }
+    }
+    if (last < 0)
+        return false;
+
+    path.push_back(to);
+    for (int c = last; c != count; c = parents[c])
+        path.push_back(corners[c].point);
+    path.push_back(from);
+    std::reverse(path.begin(), path.end());
+    return true;
+}
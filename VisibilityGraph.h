@@ -0,0 +1,64 @@
+#pragma once
+#include "NavObstacle.h"
+#include "Vector2.h"
+#include <vector>
+
+// Visibility graph over the corners of the obstacles grown by the agent's
+// radius. Among box obstacles a shortest path only ever bends at such corners,
+// so searching the corners that see each other gives exact shortest paths with
+// a few nodes per obstacle, whatever the size of the world. Which corners see
+// each other is worked out once; a query only links its start and finish to
+// the corners they see. Only edges a taut path can use are kept: at each end
+// the segment must touch its box without cutting into it.
+class VisibilityGraph {
+public:
+    struct Edge {
+        int to;
+        float cost;
+    };
+
+private:
+    float agentRadius = 0.0f;
+    float minX = 0.0f;
+    float minY = 0.0f;
+    float maxX = 0.0f;
+    float maxY = 0.0f;
+
+    struct Corner {
+        Vector2 point;
+        int xSide; // +1 on the box's right edge, -1 on its left
+        int ySide;
+
+        // Whether a path can bend here on its way along direction: only when the
+        // line through the corner passes the box by instead of cutting into it
+        bool isTangent(const Vector2& direction) const
+        {
+            return xSide * ySide * direction.getX() * direction.getY() <= 0.0f;
+        }
+    };
+
+    std::vector<NavBox> boxes;
+    std::vector<Corner> corners;
+    std::vector<int> firstEdges; // per corner, its edges run up to the next corner's first, one extra at the end
+    std::vector<Edge> edges;
+
+    bool isFree(const Vector2& point) const;
+    Vector2 moveOut(const Vector2& point) const;
+
+public:
+    // The walkable area is the bounds less the agent's radius on every side
+    VisibilityGraph(const std::vector<NavObstacle>& obstacles, float minX, float minY, float maxX, float maxY, float agentRadius);
+    ~VisibilityGraph() = default;
+
+    // True when the straight segment between the two points passes no obstacle
+    bool isVisible(const Vector2& a, const Vector2& b) const;
+
+    // Shortest path between the points, ends inside an obstacle moved to its edge.
+    // Fills path with the start, every corner the path turns at and the finish;
+    // false, with path empty, when the two are not connected.
+    bool findPath(const Vector2& start, const Vector2& finish, std::vector<Vector2>& path) const;
+
+    float getAgentRadius() const { return agentRadius; }
+    size_t getCornerCount() const { return corners.size(); }
+    size_t getEdgeCount() const { return edges.size(); }
+};